@@ -0,0 +1,74 @@
+#define OE_CLIENT_INCLUDE_ENTRY_POINT
+#include <OverEngine.h>
+
+#include "Renderer2DBenchmarks.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+
+#include <filesystem>
+
+class BenchmarkApp : public OverEngine::Application
+{
+public:
+	BenchmarkApp(const OverEngine::ApplicationProps& props, const BenchmarkSettings& settings)
+		: OverEngine::Application(props)
+	{
+		m_Window->SetVSync(false);
+		PushLayer(new Renderer2DBenchmarks(settings));
+	}
+};
+
+/**
+ * OverEngineBenchmarks [--opengl] [--instanced] [--quads N] [--frames N] [--warmup N] [--scenario NAME] [--replay FILE] [--output FILE]
+ * Runs on the Null renderer unless --opengl is given, so it works on machines without a GPU.
+ * --instanced submits quads through Renderer2D's instanced path instead of four vertices each.
+ * --replay measures a Renderer2D capture (see Renderer2DCapture) instead of the built-in scenarios.
+ */
+OverEngine::Application* OverEngine::CreateApplication(int argc, char** argv)
+{
+	OverEngine::ApplicationProps props;
+	props.MainWindowProps.Title = "OverEngine Benchmarks";
+	props.RendererAPI = OverEngine::RendererAPI::API::Null;
+
+	BenchmarkSettings settings;
+
+	for (int i = 1; i < argc; i++)
+	{
+		String arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--opengl")
+			props.RendererAPI = OverEngine::RendererAPI::API::OpenGL;
+		else if (arg == "--instanced")
+			settings.Instanced = true;
+		else if (arg == "--quads" && hasValue)
+			settings.QuadCount = (uint32_t)std::stoul(argv[++i]);
+		else if (arg == "--frames" && hasValue)
+			settings.Frames = std::max((uint32_t)std::stoul(argv[++i]), 1u);
+		else if (arg == "--warmup" && hasValue)
+			settings.WarmupFrames = (uint32_t)std::stoul(argv[++i]);
+		else if (arg == "--scenario" && hasValue)
+			settings.Filter = argv[++i];
+		else if (arg == "--replay" && hasValue)
+			settings.ReplayPath = argv[++i];
+		else if (arg == "--output" && hasValue)
+			settings.OutputPath = argv[++i];
+		else
+			std::cerr << "Unknown argument '" << arg << "'" << std::endl;
+	}
+
+	// Keep atlases small enough that the many textures scenario ends up on more pages than texture slots
+	OverEngine::NullRendererAPI::SetLimits(2048, 16);
+
+	#ifdef OE_BENCHMARKS_WORKING_DIRECTORY
+	if (!std::filesystem::exists("assets"))
+	{
+		settings.OutputPath = std::filesystem::absolute(settings.OutputPath).string();
+		if (!settings.ReplayPath.empty())
+			settings.ReplayPath = std::filesystem::absolute(settings.ReplayPath).string();
+		std::filesystem::current_path(OE_BENCHMARKS_WORKING_DIRECTORY);
+	}
+	#endif
+
+	return new BenchmarkApp(props, settings);
+}
@@ -0,0 +1,375 @@
+#include "Renderer2DBenchmarks.h"
+
+#include <json.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <fstream>
+#include <random>
+
+static constexpr uint32_t s_Seed = 1234;
+static constexpr float s_WorldSize = 100.0f;
+
+static const Mat4x4 s_ViewProjection = glm::ortho(-s_WorldSize, s_WorldSize, -s_WorldSize, s_WorldSize, -1.0f, 1.0f);
+
+static Mat4x4 RandomTransform(std::mt19937& random, float minZ = 0.0f, float maxZ = 0.0f)
+{
+	std::uniform_real_distribution<float> position(-s_WorldSize, s_WorldSize);
+	std::uniform_real_distribution<float> depth(minZ, maxZ);
+	std::uniform_real_distribution<float> rotation(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+	Vector3 translation = { position(random), position(random), depth(random) };
+	return glm::translate(IDENTITY_MAT4X4, translation) *
+		glm::rotate(IDENTITY_MAT4X4, rotation(random), { 0.0f, 0.0f, 1.0f }) *
+		glm::scale(IDENTITY_MAT4X4, { size(random), size(random), 1.0f });
+}
+
+static Color RandomColor(std::mt19937& random, float alpha = 1.0f)
+{
+	std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+	return { channel(random), channel(random), channel(random), alpha };
+}
+
+// Nearest rank percentile of sorted samples, the smallest sample with at least percentile of them at or below it
+static double Percentile(const Vector<double>& sorted, double percentile)
+{
+	size_t rank = (size_t)std::ceil(percentile * (double)sorted.size() - 1e-9); // Epsilon absorbs rounding of an exact product
+	return sorted[std::clamp(rank, (size_t)1, sorted.size()) - 1];
+}
+
+Renderer2DBenchmarks::Renderer2DBenchmarks(const BenchmarkSettings& settings)
+	: Layer("Renderer2DBenchmarks"), m_Settings(settings)
+{
+	Renderer2D::SetInstancedRendering(m_Settings.Instanced);
+	LoadTextures();
+}
+
+void Renderer2DBenchmarks::LoadTextures()
+{
+	m_AtlasTexture = Texture2D::CreateMaster("assets/textures/platformPack_tilesheet@2.png");
+
+	const uint32_t tileSize = 128;
+	for (uint32_t y = 0; y + tileSize <= m_AtlasTexture->GetHeight(); y += tileSize)
+		for (uint32_t x = 0; x + tileSize <= m_AtlasTexture->GetWidth(); x += tileSize)
+			m_AtlasTiles.push_back(Texture2D::CreateSubTexture(m_AtlasTexture, { (float)x, (float)y, (float)tileSize, (float)tileSize }));
+
+	// Load copies until TextureManager has to spread them over more GPU textures than can be bound at once.
+	// Every copy is kept alive (a destroyed copy frees its rect for the next one), the scenario draws one copy per GPU texture
+	const uint32_t maxCopies = 1 << 16;
+	uint32_t requiredGPUTextures = RenderCommand::GetMaxTextureSlotCount() + 1;
+
+	for (uint32_t i = 0; i < maxCopies && m_SeparateTextures.size() < requiredGPUTextures; i++)
+	{
+		Ref<Texture2D> texture = Texture2D::CreateMaster("assets/textures/Checkerboard.png");
+		m_TextureCopies.push_back(texture);
+
+		auto it = std::find_if(m_SeparateTextures.begin(), m_SeparateTextures.end(), [&texture](const Ref<Texture2D>& other) {
+			return *other->GetGPUTexture() == *texture->GetGPUTexture();
+		});
+
+		if (it == m_SeparateTextures.end())
+			m_SeparateTextures.push_back(texture);
+	}
+
+	if (m_SeparateTextures.size() < requiredGPUTextures)
+	{
+		OE_WARN("many_textures: {0} copies only filled {1} GPU textures, {2} texture slots can be bound at once",
+			m_TextureCopies.size(), m_SeparateTextures.size(), RenderCommand::GetMaxTextureSlotCount());
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Scenarios ////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+Renderer2DBenchmarks::Scenario Renderer2DBenchmarks::FlatColorScenario()
+{
+	std::mt19937 random(s_Seed);
+
+	Scenario scenario{ "flat_color" };
+	scenario.Cameras.push_back(s_ViewProjection);
+
+	for (uint32_t i = 0; i < m_Settings.QuadCount; i++)
+		scenario.Quads.push_back({ RandomTransform(random), RandomColor(random), nullptr });
+
+	return scenario;
+}
+
+Renderer2DBenchmarks::Scenario Renderer2DBenchmarks::AtlasScenario()
+{
+	std::mt19937 random(s_Seed);
+	std::uniform_int_distribution<size_t> tile(0, m_AtlasTiles.size() - 1);
+
+	Scenario scenario{ "atlas_textured" };
+	scenario.Cameras.push_back(s_ViewProjection);
+
+	for (uint32_t i = 0; i < m_Settings.QuadCount; i++)
+		scenario.Quads.push_back({ RandomTransform(random), Color(1.0f), m_AtlasTiles[tile(random)] });
+
+	return scenario;
+}
+
+Renderer2DBenchmarks::Scenario Renderer2DBenchmarks::ManyTexturesScenario()
+{
+	std::mt19937 random(s_Seed);
+	std::uniform_int_distribution<size_t> texture(0, m_SeparateTextures.size() - 1);
+
+	Scenario scenario{ "many_textures" };
+	scenario.Cameras.push_back(s_ViewProjection);
+
+	for (uint32_t i = 0; i < m_Settings.QuadCount; i++)
+		scenario.Quads.push_back({ RandomTransform(random), Color(1.0f), m_SeparateTextures[texture(random)] });
+
+	return scenario;
+}
+
+Renderer2DBenchmarks::Scenario Renderer2DBenchmarks::MixedTransparencyScenario()
+{
+	std::mt19937 random(s_Seed);
+	std::uniform_int_distribution<size_t> tile(0, m_AtlasTiles.size() - 1);
+	std::bernoulli_distribution coin(0.5);
+
+	Scenario scenario{ "mixed_transparency" };
+	scenario.Cameras.push_back(s_ViewProjection);
+
+	for (uint32_t i = 0; i < m_Settings.QuadCount; i++)
+	{
+		float alpha = coin(random) ? 1.0f : 0.5f;
+		Mat4x4 transform = RandomTransform(random, -0.9f, 0.9f);
+
+		if (coin(random))
+			scenario.Quads.push_back({ transform, RandomColor(random, alpha), nullptr });
+		else
+			scenario.Quads.push_back({ transform, Color(1.0f, 1.0f, 1.0f, alpha), m_AtlasTiles[tile(random)] });
+	}
+
+	return scenario;
+}
+
+Renderer2DBenchmarks::Scenario Renderer2DBenchmarks::MultiCameraScenario()
+{
+	Scenario scenario = AtlasScenario();
+	scenario.Name = "multi_camera";
+
+	// Split screen quarters and a zoomed out minimap
+	scenario.Cameras = {
+		glm::ortho(-s_WorldSize, 0.0f, 0.0f, s_WorldSize, -1.0f, 1.0f),
+		glm::ortho(0.0f, s_WorldSize, 0.0f, s_WorldSize, -1.0f, 1.0f),
+		glm::ortho(-s_WorldSize, 0.0f, -s_WorldSize, 0.0f, -1.0f, 1.0f),
+		glm::ortho(0.0f, s_WorldSize, -s_WorldSize, 0.0f, -1.0f, 1.0f),
+		glm::ortho(-2.0f * s_WorldSize, 2.0f * s_WorldSize, -2.0f * s_WorldSize, 2.0f * s_WorldSize, -1.0f, 1.0f),
+	};
+
+	return scenario;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Running //////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////
+
+double Renderer2DBenchmarks::SubmitFrame(const Scenario& scenario)
+{
+	RenderCommand::Clear();
+
+	double start = Time::GetTimeDouble();
+
+	Renderer2D::BeginGeometry();
+
+	TexturedQuadExtraData extraData;
+	for (const auto& quad : scenario.Quads)
+	{
+		if (quad.Texture)
+		{
+			extraData.Tint = quad.Tint;
+			Renderer2D::DrawQuad(quad.Transform, quad.Texture, extraData);
+		}
+		else
+		{
+			Renderer2D::DrawQuad(quad.Transform, quad.Tint);
+		}
+	}
+
+	Renderer2D::EndGeometry();
+
+	for (const auto& camera : scenario.Cameras)
+		Renderer2D::DrawGeometry(camera);
+
+	double elapsed = Time::GetTimeDouble() - start;
+
+	Application::Get().GetWindow().OnUpdate();
+	return elapsed;
+}
+
+double Renderer2DBenchmarks::SubmitReplayFrame(Renderer2DReplay& replay, uint32_t frame)
+{
+	double start = Time::GetTimeDouble();
+	replay.ReplayFrame(frame);
+	double elapsed = Time::GetTimeDouble() - start;
+
+	Application::Get().GetWindow().OnUpdate();
+	return elapsed;
+}
+
+// Fills everything but the quad, camera and texture counts; submitFrame gets the frame index and returns its time
+Renderer2DBenchmarks::ScenarioResult Renderer2DBenchmarks::Measure(const String& name, uint32_t quadsPerFrame, const std::function<double(uint32_t)>& submitFrame)
+{
+	// All frames run inside one Application update, so each starts its own Renderer2D frame
+	for (uint32_t i = 0; i < m_Settings.WarmupFrames; i++)
+	{
+		Renderer2D::BeginFrame();
+		submitFrame(i);
+	}
+
+	Vector<double> frameTimes;
+	frameTimes.reserve(m_Settings.Frames);
+
+	uint64_t uploadedBytes = 0;
+	uint64_t drawCalls = 0;
+
+	for (uint32_t i = 0; i < m_Settings.Frames; i++)
+	{
+		Renderer2D::BeginFrame();
+		frameTimes.push_back(submitFrame(m_Settings.WarmupFrames + i));
+
+		uploadedBytes += Renderer2D::GetStatistics().UploadedBytes;
+		drawCalls += Renderer2D::GetStatistics().DrawCalls;
+	}
+
+	double totalTime = 0.0;
+	for (double time : frameTimes)
+		totalTime += time;
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	ScenarioResult result;
+	result.Name = name;
+	result.QuadCount = quadsPerFrame;
+	result.CameraCount = 0;
+	result.GPUTextureCount = 0;
+
+	result.QuadsPerSecond = totalTime > 0.0 ? (double)quadsPerFrame * m_Settings.Frames / totalTime : 0.0;
+	result.UploadedBytesPerFrame = (double)uploadedBytes / m_Settings.Frames;
+	result.DrawCallsPerFrame = (double)drawCalls / m_Settings.Frames;
+
+	result.MeanMilliseconds = 1000.0 * totalTime / m_Settings.Frames;
+	result.P50Milliseconds = 1000.0 * Percentile(frameTimes, 0.50);
+	result.P99Milliseconds = 1000.0 * Percentile(frameTimes, 0.99);
+
+	OE_INFO("{0}: {1:.0f} quads/s, {2:.0f} draw calls, p50 {3:.3f} ms, p99 {4:.3f} ms",
+		result.Name, result.QuadsPerSecond, result.DrawCallsPerFrame, result.P50Milliseconds, result.P99Milliseconds);
+
+	return result;
+}
+
+static uint32_t CountGPUTextures(const Vector<Ref<Texture2D>>& textures)
+{
+	Vector<GAPI::Texture2D*> gpuTextures;
+	for (const auto& texture : textures)
+	{
+		if (texture && STD_CONTAINER_FIND(gpuTextures, texture->GetGPUTexture().get()) == gpuTextures.end())
+			gpuTextures.push_back(texture->GetGPUTexture().get());
+	}
+	return (uint32_t)gpuTextures.size();
+}
+
+Renderer2DBenchmarks::ScenarioResult Renderer2DBenchmarks::Run(const Scenario& scenario)
+{
+	ScenarioResult result = Measure(scenario.Name, (uint32_t)scenario.Quads.size(), [&](uint32_t) { return SubmitFrame(scenario); });
+
+	Vector<Ref<Texture2D>> textures;
+	for (const auto& quad : scenario.Quads)
+		textures.push_back(quad.Texture);
+
+	result.CameraCount = (uint32_t)scenario.Cameras.size();
+	result.GPUTextureCount = CountGPUTextures(textures);
+	return result;
+}
+
+// Frames of the capture are replayed in a loop; quad and camera counts are averages per frame
+Renderer2DBenchmarks::ScenarioResult Renderer2DBenchmarks::RunReplay(Renderer2DReplay& replay)
+{
+	uint32_t frameCount = replay.GetFrameCount();
+	uint32_t quadsPerFrame = (uint32_t)(replay.GetQuadCount() / frameCount);
+
+	ScenarioResult result = Measure("replay", quadsPerFrame, [&](uint32_t frame) { return SubmitReplayFrame(replay, frame % frameCount); });
+	result.CameraCount = (uint32_t)(replay.GetCameraCount() / frameCount);
+	result.GPUTextureCount = CountGPUTextures(replay.GetTextures());
+	return result;
+}
+
+void Renderer2DBenchmarks::OnUpdate(TimeStep DeltaTime)
+{
+	using ScenarioFactory = Scenario(Renderer2DBenchmarks::*)();
+	const ScenarioFactory factories[] = {
+		&Renderer2DBenchmarks::FlatColorScenario,
+		&Renderer2DBenchmarks::AtlasScenario,
+		&Renderer2DBenchmarks::ManyTexturesScenario,
+		&Renderer2DBenchmarks::MixedTransparencyScenario,
+		&Renderer2DBenchmarks::MultiCameraScenario,
+	};
+
+	Vector<ScenarioResult> results;
+	if (!m_Settings.ReplayPath.empty())
+	{
+		Renderer2DReplay replay;
+		if (replay.Load(m_Settings.ReplayPath) && replay.GetFrameCount() > 0)
+			results.push_back(RunReplay(replay));
+		else
+			OE_ERROR("Nothing to replay in '{0}'!", m_Settings.ReplayPath);
+	}
+	else
+	{
+		for (auto factory : factories)
+		{
+			Scenario scenario = (this->*factory)();
+			if (m_Settings.Filter.empty() || m_Settings.Filter == scenario.Name)
+				results.push_back(Run(scenario));
+		}
+	}
+
+	WriteResults(results);
+	Application::Get().Close();
+}
+
+void Renderer2DBenchmarks::WriteResults(const Vector<ScenarioResult>& results)
+{
+	nlohmann::json json;
+
+	json["engine_version"] = "0.0";
+	json["renderer_api"] = RendererAPI::GetAPI() == RendererAPI::API::Null ? "Null" : "OpenGL";
+	json["renderer"] = Application::Get().GetWindow().GetRendererContext().GetInfoRenderer();
+	json["instanced_rendering"] = Renderer2D::IsInstancedRendering();
+	json["warmup_frames"] = m_Settings.WarmupFrames;
+	json["frames"] = m_Settings.Frames;
+
+	nlohmann::json& scenarios = json["scenarios"];
+	scenarios = nlohmann::json::array();
+
+	for (const auto& result : results)
+	{
+		nlohmann::json scenario;
+		scenario["name"] = result.Name;
+		scenario["quads"] = result.QuadCount;
+		scenario["cameras"] = result.CameraCount;
+		scenario["gpu_textures"] = result.GPUTextureCount;
+		scenario["quads_per_second"] = result.QuadsPerSecond;
+		scenario["uploaded_bytes_per_frame"] = result.UploadedBytesPerFrame;
+		scenario["draw_calls_per_frame"] = result.DrawCallsPerFrame;
+		scenario["frame_submission_ms"] = {
+			{ "mean", result.MeanMilliseconds },
+			{ "p50", result.P50Milliseconds },
+			{ "p99", result.P99Milliseconds },
+		};
+		scenarios.push_back(scenario);
+	}
+
+	std::ofstream file(m_Settings.OutputPath);
+	if (!file)
+	{
+		OE_ERROR("Can't write benchmark results to '{0}'!", m_Settings.OutputPath);
+		return;
+	}
+
+	file << json.dump(4) << std::endl;
+	OE_INFO("Benchmark results written to '{0}'", m_Settings.OutputPath);
+}
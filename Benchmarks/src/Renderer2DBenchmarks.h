@@ -0,0 +1,86 @@
+#pragma once
+
+#include <OverEngine.h>
+
+using namespace OverEngine;
+
+struct BenchmarkSettings
+{
+	uint32_t QuadCount = 10000;
+	uint32_t WarmupFrames = 10;
+	uint32_t Frames = 200;
+	bool Instanced = false; // Renderer2D::SetInstancedRendering
+
+	String OutputPath = "Renderer2DBenchmarks.json";
+	String Filter; // Runs only scenarios with this name when not empty
+	String ReplayPath; // Replays this Renderer2D capture instead of the scenarios when not empty
+};
+
+/**
+ * Runs every Renderer2D scenario once (on the first update), writes the results as JSON and closes the application.
+ * Frame submission time covers BeginGeometry to the last DrawGeometry, presenting the frame is excluded.
+ */
+class Renderer2DBenchmarks : public Layer
+{
+public:
+	Renderer2DBenchmarks(const BenchmarkSettings& settings);
+
+	void OnUpdate(TimeStep DeltaTime) override;
+
+private:
+	struct BenchmarkQuad
+	{
+		Mat4x4 Transform;
+		Color Tint;
+		Ref<Texture2D> Texture;
+	};
+
+	struct Scenario
+	{
+		String Name;
+		Vector<BenchmarkQuad> Quads;
+		Vector<Mat4x4> Cameras;
+	};
+
+	struct ScenarioResult
+	{
+		String Name;
+		uint32_t QuadCount;
+		uint32_t CameraCount;
+		uint32_t GPUTextureCount;
+
+		double QuadsPerSecond;
+		double UploadedBytesPerFrame;
+		double DrawCallsPerFrame;
+
+		double MeanMilliseconds;
+		double P50Milliseconds;
+		double P99Milliseconds;
+	};
+
+	void LoadTextures();
+
+	Scenario FlatColorScenario();
+	Scenario AtlasScenario();
+	Scenario ManyTexturesScenario();
+	Scenario MixedTransparencyScenario();
+	Scenario MultiCameraScenario();
+
+	ScenarioResult Measure(const String& name, uint32_t quadsPerFrame, const std::function<double(uint32_t)>& submitFrame);
+
+	ScenarioResult Run(const Scenario& scenario);
+	double SubmitFrame(const Scenario& scenario);
+
+	ScenarioResult RunReplay(Renderer2DReplay& replay);
+	double SubmitReplayFrame(Renderer2DReplay& replay, uint32_t frame);
+
+	void WriteResults(const Vector<ScenarioResult>& results);
+
+private:
+	BenchmarkSettings m_Settings;
+
+	Ref<Texture2D> m_AtlasTexture;
+	Vector<Ref<Texture2D>> m_AtlasTiles;
+	Vector<Ref<Texture2D>> m_SeparateTextures; // One copy per GPU texture
+	Vector<Ref<Texture2D>> m_TextureCopies; // Every copy loaded to fill those GPU textures
+};
@@ -117,7 +117,17 @@ namespace OverEditor
 	template <>
 	void ComponentEditor<SpriteRendererComponent>(Entity entity, uint32_t typeID)
 	{
-		if (UIElements::BeginComponentEditor<SpriteRendererComponent>(entity, "SpriteRenderer Component", typeID))
+		// Fields are edited in place, retained rendering is told to rewrite the sprite after an edit
+		bool wasEnabled = entity.GetComponent<SpriteRendererComponent>().Enabled;
+		bool open = UIElements::BeginComponentEditor<SpriteRendererComponent>(entity, "SpriteRenderer Component", typeID);
+
+		// A removed component is dropped by Scene::OnSpriteDestroyed
+		if (!entity.HasComponent<SpriteRendererComponent>())
+			return;
+
+		bool changed = entity.GetComponent<SpriteRendererComponent>().Enabled != wasEnabled;
+
+		if (open)
 		{
 			UIElements::BeginFieldGroup();
 
@@ -127,7 +137,10 @@ namespace OverEditor
 			static Color tintDelta(0.0f);
 
 			if (UIElements::Color4Field("Tint", "##Tint", glm::value_ptr(tint)))
+			{
 				tintDelta += tint - sp.Tint;
+				changed = true;
+			}
 
 			if (ImGui::IsItemDeactivatedAfterEdit())
 			{
@@ -135,6 +148,7 @@ namespace OverEditor
 					return entity.GetComponent<SpriteRendererComponent>().Tint;
 				}, [entity](const auto& col) mutable {
 					entity.GetComponent<SpriteRendererComponent>().Tint = col;
+					entity.GetScene()->MarkSpriteChanged(entity);
 				});
 
 				EditorLayer::Get().GetActionStack().Do(action, false);
@@ -143,39 +157,44 @@ namespace OverEditor
 
 			sp.Tint = tint;
 
-			UIElements::DragFloatField("AlphaClipThreshold", "##AlphaClipThreshold", &sp.AlphaClipThreshold, 0.02f, 0.0f, 1.0f);
-			UIElements::Texture2DField("Sprite", "##Sprite", sp.Sprite);
+			changed |= UIElements::DragFloatField("AlphaClipThreshold", "##AlphaClipThreshold", &sp.AlphaClipThreshold, 0.02f, 0.0f, 1.0f);
+			changed |= UIElements::Texture2DField("Sprite", "##Sprite", sp.Sprite);
 
 			if (sp.Sprite && sp.Sprite->GetType() != TextureType::Placeholder)
 			{
-				UIElements::CheckboxField("Flip.x", "##Flip.x", &sp.Flip.x);
-				UIElements::CheckboxField("Flip.y", "##Flip.y", &sp.Flip.y);
+				changed |= UIElements::CheckboxField("Flip.x", "##Flip.x", &sp.Flip.x);
+				changed |= UIElements::CheckboxField("Flip.y", "##Flip.y", &sp.Flip.y);
 
-				UIElements::DragFloat2Field("Tiling", "##Tiling", glm::value_ptr(sp.Tiling), 0.02f);
-				UIElements::DragFloat2Field("Offset", "##Offset", glm::value_ptr(sp.Offset), 0.02f);
+				changed |= UIElements::DragFloat2Field("Tiling", "##Tiling", glm::value_ptr(sp.Tiling), 0.02f);
+				changed |= UIElements::DragFloat2Field("Offset", "##Offset", glm::value_ptr(sp.Offset), 0.02f);
 
 				static UIElements::EnumValues wrappingValues = {
 					{ 0, "None (Use texture default value)" }, { 1, "Repeat" },
 					{ 2, "MirroredRepeat" }, { 3, "ClampToEdge" },{ 4, "ClampToBorder" }
 				};
-				UIElements::BasicEnum("Wrapping.x", "##Wrapping.x", wrappingValues, (int8_t*)&sp.Wrapping.x);
-				UIElements::BasicEnum("Wrapping.y", "##Wrapping.y", wrappingValues, (int8_t*)&sp.Wrapping.y);
+				changed |= UIElements::BasicEnum("Wrapping.x", "##Wrapping.x", wrappingValues, (int8_t*)&sp.Wrapping.x);
+				changed |= UIElements::BasicEnum("Wrapping.y", "##Wrapping.y", wrappingValues, (int8_t*)&sp.Wrapping.y);
 
 				static UIElements::EnumValues filteringValues = {
 					{ 0, "None (Use texture default value)" }, { 1, "Point" }, { 2, "Linear" }
 				};
-				UIElements::BasicEnum("Filtering", "##Filtering", filteringValues, (int8_t*)&sp.Filtering);
+				changed |= UIElements::BasicEnum("Filtering", "##Filtering", filteringValues, (int8_t*)&sp.Filtering);
 
-				UIElements::CheckboxField("OverrideTextureBorderColor (for ClampToBorder wrapping)",
+				changed |= UIElements::CheckboxField("OverrideTextureBorderColor (for ClampToBorder wrapping)",
 					"##OverrideTextureBorderColor", &sp.TextureBorderColor.first);
 
 				if (sp.TextureBorderColor.first)
-					UIElements::Color4Field("TextureBorderColor (for ClampToBorder wrapping)",
+				{
+					changed |= UIElements::Color4Field("TextureBorderColor (for ClampToBorder wrapping)",
 						"##BorderColor", glm::value_ptr(sp.TextureBorderColor.second));
+				}
 			}
 
 			UIElements::EndFieldGroup();
 		}
+
+		if (changed)
+			entity.GetScene()->MarkSpriteChanged(entity);
 	}
 
 	template <>
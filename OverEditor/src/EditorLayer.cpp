@@ -36,6 +36,9 @@ namespace OverEditor
 		m_ViewportPanel.SetContext(m_SceneContext);
 		m_SceneHierarchyPanel.SetContext(m_SceneContext);
 
+		// Project textures are read again from their files when an atlas needs them
+		TextureManager::SetReleasePixels(true);
+
 		m_IconsTexture = Texture2D::CreateMaster("assets/textures/Icons.png");
 		m_Icons["FolderIcon"] = Texture2D::CreateSubTexture(m_IconsTexture, { 256, 0, 256, 256 });
 		m_Icons["SceneIcon"] = Texture2D::CreateSubTexture(m_IconsTexture, { 0, 0, 256, 256 });
@@ -71,6 +74,13 @@ namespace OverEditor
 					sceneSerializer.Serialize(m_EditingProject->GetAssetsDirectoryPath() + m_SceneContext->PrimaryScene->GetPath());
 				}
 
+				// Loaded from their cooked files from the next project load on
+				if (ImGui::MenuItem("Cook Textures", nullptr, nullptr, (bool)m_EditingProject))
+				{
+					uint32_t count = TextureCooker::CookDirectory(m_EditingProject->GetAssetsDirectoryPath(), TextureManager::GetGutter(), TextureManager::IsMipmapsEnabled());
+					OE_CORE_INFO("Cooked {0} textures", count);
+				}
+
 				ImGui::Separator();
 
 				if (ImGui::MenuItem("Quit Editor", "Alt+F4"))
@@ -132,6 +132,10 @@ namespace OverEditor
 			if (ImGui::Button("Step"))
 				m_Context->RuntimeFlags ^= SceneEditor::RuntimeFlags_SimulationStepNextFrame;
 
+			ImGui::SameLine();
+
+			ImGui::Checkbox("Statistics", &m_ShowStatistics);
+
 			ImGui::EndMenuBar();
 
 			// Resize
@@ -145,6 +149,7 @@ namespace OverEditor
 
 			// Draw FrameBuffer
 			ImGui::Image((void*)(intptr_t)m_FrameBuffer->GetColorAttachmentRendererID(), panelSize, { 0, 1 }, { 1, 0 });
+			m_OverlayPos = IMVEC2_2_VECTOR2(ImGui::GetWindowPos()) + m_PanelPos;
 
 			bool hovered = ImGui::IsWindowHovered();
 			bool rightMouseButtonDown = ImGui::IsMouseDown(ImGuiMouseButton_Right);
@@ -209,6 +214,62 @@ namespace OverEditor
 		}
 
 		ImGui::End();
+
+		if (m_ShowStatistics && m_Context->AnySceneOpen())
+			DrawStatisticsOverlay();
+	}
+
+	void ViewportPanel::DrawStatisticsOverlay()
+	{
+		const auto& stats = m_Statistics;
+
+		ImGui::SetNextWindowPos({ m_OverlayPos.x + 10.0f, m_OverlayPos.y + 10.0f }, ImGuiCond_Always);
+		ImGui::SetNextWindowBgAlpha(0.6f);
+
+		ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs |
+			ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+
+		ImGui::Begin("Viewport Statistics", nullptr, flags);
+
+		ImGui::Text("CPU Submit : %.3f ms", stats.SubmitMilliseconds);
+		ImGui::Text("CPU Flush : %.3f ms", stats.FlushMilliseconds);
+		if (stats.GPUMilliseconds > 0.0)
+		{
+			ImGui::Text("GPU : %.3f ms", stats.GPUMilliseconds);
+			ImGui::TextUnformatted(stats.IsGPUBound() ? "GPU bound" : "CPU bound");
+		}
+		else
+		{
+			ImGui::TextUnformatted("GPU : not measured");
+		}
+
+		ImGui::Separator();
+
+		ImGui::Text("Quads : %u", stats.QuadCount);
+		ImGui::Text("Batches : %u", stats.BatchCount);
+		ImGui::Text("Draw Calls : %u", stats.DrawCalls);
+		ImGui::Text("Uploaded : %.1f KiB", (double)stats.UploadedBytes / 1024.0);
+
+		ImGui::Separator();
+
+		ImGui::Text("Flushes (EndScene) : %u", stats.Flushes[Renderer2D::FlushReason_EndScene]);
+		ImGui::Text("Flushes (Descriptor Overflow) : %u", stats.Flushes[Renderer2D::FlushReason_DescriptorOverflow]);
+		ImGui::Text("Flushes (Mode Switch) : %u", stats.Flushes[Renderer2D::FlushReason_ModeSwitch]);
+		ImGui::Text("Slot Overflow Splits : %u", stats.SlotOverflowSplits);
+		ImGui::Text("Buffer Growths : %u", stats.BufferGrowths);
+
+		ImGui::Separator();
+
+		ImGui::Text("Atlas Memory : %.1f MiB", (double)TextureManager::GetAllocatedBytes() / (1024.0 * 1024.0));
+		ImGui::Text("Loading Textures : %u", TextureManager::GetPendingLoadCount());
+		for (const auto& atlas : TextureManager::GetAtlasStatistics())
+		{
+			ImGui::Text("%s %u : %u textures, %.0f%% used, %.0f%% wasted", atlas.GPUTexture->GetArrayLayer() != -1 ? "Page" : "Atlas",
+				atlas.GPUTexture->GetArrayLayer() != -1 ? (uint32_t)atlas.GPUTexture->GetArrayLayer() : atlas.GPUTexture->GetRendererID(),
+				atlas.TextureCount, atlas.Occupancy * 100.0f, atlas.WastedSpaceRatio * 100.0f);
+		}
+
+		ImGui::End();
 	}
 
 	void ViewportPanel::OnRender()
@@ -244,9 +305,14 @@ namespace OverEditor
 			DrawGrid();
 			RenderCommand::Clear(ClearFlags_ClearDepth);
 
-			Renderer2D::BeginScene(glm::inverse(m_CameraTransform.GetMatrix()), m_Camera);
-			scene->RenderSprites();
-			Renderer2D::EndScene();
+			Renderer2D::BeginGeometry();
+			scene->RenderSprites({ m_CameraTransform.GetMatrix() * glm::inverse(m_Camera.GetProjection()) });
+			Renderer2D::EndGeometry();
+
+			Renderer2D::DrawGeometry(glm::inverse(m_CameraTransform.GetMatrix()), m_Camera);
+
+			// Statistics are reset by the next Renderer2D::BeginFrame
+			m_Statistics = Renderer2D::GetStatistics();
 		}
 		else
 		{
@@ -304,6 +370,9 @@ namespace OverEditor
 			s_Data->GizmoShader->Bind();
 			s_Data->GizmoVA->Bind();
 
+			// Shared by both axes
+			s_Data->GizmoShader->UploadUniformMat4("u_ViewProjMatrix", m_Camera.GetProjection() * glm::inverse((Mat4x4)m_CameraTransform));
+
 			Transform gizmoTransform;
 			gizmoTransform.SetScale({ arrowScale * cameraOrthoSize, arrowScale / 10 * cameraOrthoSize, 1.0f * cameraOrthoSize });
 			float offset = gizmoTransform.GetScale().x / 2.0f - gizmoTransform.GetScale().y / 10.0f;
@@ -314,14 +383,12 @@ namespace OverEditor
 			};
 
 			gizmoTransform.SetPosition({ entityTransform.GetPosition().x + offset, entityTransform.GetPosition().y, 0.0f });
-			s_Data->GizmoShader->UploadUniformMat4("u_ViewProjMatrix", m_Camera.GetProjection() * glm::inverse((Mat4x4)m_CameraTransform));
 			s_Data->GizmoShader->UploadUniformMat4("u_Transform", gizmoTransform);
 			s_Data->GizmoShader->UploadUniformFloat4("u_Color", { 1.0, 0.0, 0.0, highlightAxis(Axis::X) ? 1.0 : 0.7 });
 			RenderCommand::DrawIndexed(s_Data->GizmoVA);
 
 			gizmoTransform.SetPosition({ entityTransform.GetPosition().x, entityTransform.GetPosition().y + offset, 0.0f });
 			gizmoTransform.SetEulerAngles({ 0.0f, 0.0f, 90.0f });
-			s_Data->GizmoShader->UploadUniformMat4("u_ViewProjMatrix", m_Camera.GetProjection() * glm::inverse((Mat4x4)m_CameraTransform));
 			s_Data->GizmoShader->UploadUniformMat4("u_Transform", gizmoTransform);
 			s_Data->GizmoShader->UploadUniformFloat4("u_Color", { 0.0, 1.0, 0.0, highlightAxis(Axis::Y) ? 1.0 : 0.7 });
 			RenderCommand::DrawIndexed(s_Data->GizmoVA);
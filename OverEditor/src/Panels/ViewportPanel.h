@@ -38,6 +38,7 @@ namespace OverEditor
 		void DrawGizmo(TransformComponent& entityTransform, bool hovered);
 
 		void DrawGrid();
+		void DrawStatisticsOverlay();
 	private:
 		bool m_IsOpen;
 
@@ -49,6 +50,11 @@ namespace OverEditor
 		Vector2 m_PanelSize = { 0, 0 };
 		Vector2 m_PanelPos = { 0, 0 };
 
+		// Renderer2D statistics of the last rendered frame, shown over the viewport
+		bool m_ShowStatistics = false;
+		Renderer2D::Statistics m_Statistics{};
+		Vector2 m_OverlayPos = { 0, 0 };
+
 		// Navigation
 		bool m_FDownLastFrame = false;
 		bool m_Panning = false;
@@ -58,8 +58,10 @@ namespace OverEditor
 		return changed;
 	}
 
-	void UIElements::Texture2DField(const char* fieldName, const char* fieldID, Ref<Texture2D>& texture)
+	bool UIElements::Texture2DField(const char* fieldName, const char* fieldID, Ref<Texture2D>& texture)
 	{
+		bool changed = false;
+
 		ImGui::TextUnformatted(fieldName);
 		ImGui::NextColumn();
 
@@ -85,6 +87,7 @@ namespace OverEditor
 			{
 				Ref<Texture2D>& incomingTexture = *static_cast<Ref<Texture2D>*>(payload->Data);
 				texture = incomingTexture;
+				changed = true;
 			}
 			ImGui::EndDragDropTarget();
 		}
@@ -93,10 +96,14 @@ namespace OverEditor
 		{
 			ImGui::SameLine();
 			if (ImGui::Button("X"))
-			texture = nullptr;
+			{
+				texture = nullptr;
+				changed = true;
+			}
 		}
 
 		ImGui::NextColumn();
+		return changed;
 	}
 
 	void UIElements::Texture2DDragSource(const Ref<Texture2D>& texture, const char* name, bool preview)
@@ -45,8 +45,8 @@ namespace OverEditor
 		template <typename T>
 		static bool BasicEnum(const char* fieldName, const char* fieldID, EnumValues& values, T* currentValue, const ImGuiSelectableFlags& flags = 0);
 
-		// Drag and drop
-		static void Texture2DField(const char* fieldName, const char* fieldID, Ref<Texture2D>& texture);
+		// Drag and drop, returns true if texture was replaced or cleared
+		static bool Texture2DField(const char* fieldName, const char* fieldID, Ref<Texture2D>& texture);
 		static void Texture2DDragSource(const Ref<Texture2D>& texture, const char* name, bool preview = false);
 
 		// Tooltip
@@ -37,6 +37,8 @@ project "OverEngine"
 		-- RendererAPI Files
 		"src/Platform/OpenGL/**.h",
 		"src/Platform/OpenGL/**.cpp",
+		"src/Platform/Null/**.h",
+		"src/Platform/Null/**.cpp",
 	 }
 
 	includedirs
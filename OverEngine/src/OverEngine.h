@@ -9,6 +9,7 @@
 #include "OverEngine/Core/Time/Time.h"
 #include "OverEngine/Core/Math/Math.h"
 #include "OverEngine/Core/Random.h" 
+#include "OverEngine/Core/ThreadPool.h"
 #include "OverEngine/Layers/Layer.h"
 
 #include "OverEngine/ImGui/ImGuiLayer.h"
@@ -30,6 +31,7 @@
 // ------- Renderer ------------------
 #include "OverEngine/Renderer/Renderer.h"
 #include "OverEngine/Renderer/Renderer2D.h"
+#include "OverEngine/Renderer/Renderer2DCapture.h"
 
 #include "OverEngine/Renderer/VertexArray.h"
 #include "OverEngine/Renderer/Buffer.h"
@@ -37,6 +39,7 @@
 #include "OverEngine/Renderer/Texture.h"
 #include "OverEngine/Renderer/FrameBuffer.h"
 #include "OverEngine/Renderer/TextureManager.h"
+#include "OverEngine/Renderer/CookedTexture.h"
 #include "OverEngine/Renderer/Camera.h"
 // -----------------------------------
 
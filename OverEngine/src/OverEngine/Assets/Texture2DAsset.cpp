@@ -3,6 +3,7 @@
 
 #include "OverEngine/Core/Random.h"
 #include "OverEngine/Core/Serialization/Serializer.h"
+#include "OverEngine/Renderer/CookedTexture.h"
 
 namespace OverEngine
 {
@@ -21,13 +22,34 @@ namespace OverEngine
 			});
 		}
 
+		String sourcePath = assetsDirectoryRoot + m_Path;
+		String cookedPath = TextureCooker::GetCookedPath(sourcePath);
+
 		for (auto assetNode : node["Textures"])
 		{
 			if (Serializer::GetGlobalEnumValue("TextureType", assetNode["Type"].as<String>()) == (int)TextureType::Master)
 			{
-				auto tex = Texture2D::CreateMaster(assetsDirectoryRoot + m_Path);
-				std::get<MasterTextureData>(tex->m_Data).Asset = this;
-				m_Textures[assetNode["Texture2D"].as<uint64_t>()] = tex;
+				uint64_t textureGuid = assetNode["Texture2D"].as<uint64_t>();
+
+				// A cooked file newer than the image needs no decoding, it's uploaded from the mapping right away
+				Ref<CookedTexture> cooked = TextureCooker::IsCookedUpToDate(sourcePath, cookedPath) ? CookedTexture::Open(cookedPath) : nullptr;
+				if (cooked)
+				{
+					auto tex = Texture2D::CreateMaster(cooked, sourcePath);
+					std::get<MasterTextureData>(tex->m_Data).Asset = this;
+
+					m_Textures[textureGuid] = tex;
+					continue;
+				}
+
+				// Decoded in the background, a placeholder until then
+				auto tex = Texture2D::CreateMasterAsync(sourcePath);
+				auto& placeholder = std::get<PlaceHolderTextureData>(tex->m_Data);
+				placeholder.AssetGuid = m_Guid;
+				placeholder.Texture2DGuid = textureGuid;
+				placeholder.Asset = this;
+
+				m_Textures[textureGuid] = tex;
 			}
 		}
 	}
@@ -1,5 +1,6 @@
 #pragma once
 
-#define OE_PROJECT_FILE_EXTENSION    "oep"
-#define OE_META_ASSET_FILE_EXTENSION "meta"
-#define OE_SCENE_FILE_EXTENSION      "oes"
+#define OE_PROJECT_FILE_EXTENSION        "oep"
+#define OE_META_ASSET_FILE_EXTENSION     "meta"
+#define OE_SCENE_FILE_EXTENSION          "oes"
+#define OE_COOKED_TEXTURE_FILE_EXTENSION "oetex"
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "OverEngine/Core/Core.h"
+
+namespace OverEngine
+{
+	/**
+	 * Read only view of a whole file mapped to memory, pages are read in on first access
+	 * and can be dropped by the OS again without being written anywhere.
+	 * Implemented per platform, see Platform/Linux and Platform/Windows.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Returns false if path can't be opened or is empty, unmaps the previous file either way
+		bool Open(const String& path);
+		void Close();
+
+		inline bool IsOpen() const { return m_Data != nullptr; }
+
+		inline const uint8_t* GetData() const { return m_Data; }
+		inline size_t GetSize() const { return m_Size; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+		void* m_MappingHandle = nullptr; // Windows only, the view is enough to unmap on Linux
+	};
+}
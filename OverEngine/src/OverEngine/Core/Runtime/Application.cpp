@@ -8,6 +8,8 @@
 #include "OverEngine/ImGui/ImGuiLayer.h"
 
 #include "OverEngine/Renderer/Renderer.h"
+#include "OverEngine/Renderer/Renderer2D.h"
+#include "OverEngine/Renderer/TextureManager.h"
 
 namespace OverEngine
 {
@@ -28,14 +30,20 @@ namespace OverEngine
 		OE_CORE_INFO("OverEngine v0.0");
 		#endif
 
+		RendererAPI::SetAPI(props.RendererAPI);
+
 		// Some window should exist to init Renderer
 		m_Window = Window::Create(props.MainWindowProps);
 		m_Window->SetEventCallback(BIND_FN(Application::OnEvent));
 
 		Renderer::Init();
 
-		m_ImGuiLayer = new ImGuiLayer();
-		PushOverlay(m_ImGuiLayer);
+		// ImGui backends need a native window and a GL context
+		if (RendererAPI::GetAPI() != RendererAPI::API::Null)
+		{
+			m_ImGuiLayer = new ImGuiLayer();
+			PushOverlay(m_ImGuiLayer);
+		}
 	}
 
 	Application::~Application()
@@ -72,17 +80,21 @@ namespace OverEngine
 		// Game Loop
 		while (m_Running)
 		{
+			Renderer2D::BeginFrame();
+
 			for (Layer* layer : m_LayerStack)
 				layer->OnUpdate(Time::GetDeltaTime());
 
-			if (m_ImGuiEnabled)
+			if (m_ImGuiEnabled && m_ImGuiLayer)
 			{
 				m_ImGuiLayer->Begin();
 				for (Layer* layer : m_LayerStack)
 					layer->OnImGuiRender();
 				m_ImGuiLayer->End();
 			}
-			
+
+			TextureManager::Update();
+
 			m_Window->OnUpdate();
 			Time::RecalculateDeltaTime();
 			InputSystem::OnUpdate();
@@ -5,6 +5,8 @@
 #include "OverEngine/Core/Window.h"
 #include "OverEngine/Core/Time/Time.h"
 
+#include "OverEngine/Renderer/RendererAPI.h"
+
 #include "OverEngine/Layers/LayerStack.h"
 #include "OverEngine/Events/Event.h"
 #include "OverEngine/Events/ApplicationEvent.h"
@@ -15,6 +17,9 @@ namespace OverEngine
 	{
 		WindowProps MainWindowProps;
 		OverEngine::RuntimeType RuntimeType = RuntimeType::Player;
+
+		// Use RendererAPI::API::Null to run without a GPU or display (ImGui is disabled)
+		OverEngine::RendererAPI::API RendererAPI = OverEngine::RendererAPI::API::OpenGL;
 	};
 
 	class ImGuiLayer;
@@ -45,7 +50,7 @@ namespace OverEngine
 		bool m_Minimized = false;
 
 		LayerStack  m_LayerStack;
-		ImGuiLayer* m_ImGuiLayer;
+		ImGuiLayer* m_ImGuiLayer = nullptr;
 		bool m_ImGuiEnabled = false;
 	private:
 		static Application* s_Instance;
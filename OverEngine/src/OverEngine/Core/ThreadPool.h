@@ -0,0 +1,36 @@
+#pragma once
+
+#include "OverEngine/Core/Core.h"
+
+#include <condition_variable>
+#include <deque>
+
+namespace OverEngine
+{
+	/**
+	 * Worker threads running submitted jobs in submission order.
+	 * Jobs must not call the graphics API, they hand their results back to the main thread themselves.
+	 */
+	class ThreadPool
+	{
+	public:
+		// 0 uses one thread less than the hardware has (at least one)
+		ThreadPool(uint32_t threadCount = 0);
+
+		// Running jobs finish, queued ones are dropped
+		~ThreadPool();
+
+		void Submit(std::function<void()> job);
+
+		inline uint32_t GetThreadCount() const { return (uint32_t)m_Threads.size(); }
+	private:
+		void Worker();
+	private:
+		Vector<std::thread> m_Threads;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		std::deque<std::function<void()>> m_Jobs;
+		bool m_Stopping = false;
+	};
+}
@@ -4,6 +4,8 @@
 #include "OverEngine/Renderer/RendererAPI.h"
 #include "OverEngine/Core/Window.h"
 
+#include "Platform/OpenGL/GLStateCache.h"
+
 #define IMGUI_IMPL_OPENGL_LOADER_DONT_CARE
 #include <imgui/backends/imgui_impl_opengl3.h>
 #include <imgui/backends/imgui_impl_glfw.h>
@@ -31,6 +33,9 @@ namespace OverEngine
 		case RendererAPI::API::OpenGL:
 			ImGui_ImplGlfw_InitForOpenGL(static_cast<GLFWwindow*>(window->GetNativeWindow()), true);
 			break;
+		case RendererAPI::API::Null:
+			OE_CORE_ASSERT(false, "ImGui is not available with RendererAPI::Null!");
+			break;
 		}
 
 		s_PlatformShutdownFunction = ImGui_ImplGlfw_Shutdown;
@@ -46,7 +51,16 @@ namespace OverEngine
 			ImGui_ImplOpenGL3_Init("#version 410");
 			s_RendererShutdownFunction = ImGui_ImplOpenGL3_Shutdown;
 			s_RendererNewFrameFunction = ImGui_ImplOpenGL3_NewFrame;
-			s_RenderFunction = ImGui_ImplOpenGL3_RenderDrawData;
+			s_RenderFunction = [](ImDrawData* drawData)
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(drawData);
+
+				// Backend changes GL state behind GLStateCache's back
+				GLStateCache::Invalidate();
+			};
+			break;
+		case RendererAPI::API::Null:
+			OE_CORE_ASSERT(false, "ImGui is not available with RendererAPI::Null!");
 			break;
 		}
 	}
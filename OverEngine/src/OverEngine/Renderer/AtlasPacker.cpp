@@ -0,0 +1,143 @@
+#include "pcheader.h"
+#include "AtlasPacker.h"
+
+namespace OverEngine
+{
+	AtlasPacker::AtlasPacker(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height)
+	{
+		Clear();
+	}
+
+	void AtlasPacker::Clear()
+	{
+		m_UsedArea = 0;
+		m_FreeRects.clear();
+		m_FreeRects.push_back({ 0, 0, m_Width, m_Height });
+	}
+
+	bool AtlasPacker::Insert(uint32_t width, uint32_t height, AtlasRect& rect)
+	{
+		if (width == 0 || height == 0)
+			return false;
+
+		// Best short side fit, ties broken by the smaller free rect
+		size_t best = m_FreeRects.size();
+		uint32_t bestShortSide = UINT32_MAX;
+		uint64_t bestArea = UINT64_MAX;
+
+		for (size_t i = 0; i < m_FreeRects.size(); i++)
+		{
+			const AtlasRect& free = m_FreeRects[i];
+			if (free.Width < width || free.Height < height)
+				continue;
+
+			uint32_t shortSide = std::min(free.Width - width, free.Height - height);
+			uint64_t area = free.GetArea();
+
+			if (shortSide < bestShortSide || (shortSide == bestShortSide && area < bestArea))
+			{
+				best = i;
+				bestShortSide = shortSide;
+				bestArea = area;
+			}
+		}
+
+		if (best == m_FreeRects.size())
+			return false;
+
+		AtlasRect free = m_FreeRects[best];
+		m_FreeRects[best] = m_FreeRects.back();
+		m_FreeRects.pop_back();
+
+		rect = { free.X, free.Y, width, height };
+		m_UsedArea += rect.GetArea();
+
+		// Split along the shorter leftover axis, keeps the bigger piece as large as possible
+		uint32_t leftoverWidth = free.Width - width;
+		uint32_t leftoverHeight = free.Height - height;
+
+		AtlasRect right, bottom;
+		if (leftoverWidth < leftoverHeight)
+		{
+			right = { free.X + width, free.Y, leftoverWidth, height };
+			bottom = { free.X, free.Y + height, free.Width, leftoverHeight };
+		}
+		else
+		{
+			right = { free.X + width, free.Y, leftoverWidth, free.Height };
+			bottom = { free.X, free.Y + height, width, leftoverHeight };
+		}
+
+		if (right.GetArea())
+			m_FreeRects.push_back(right);
+		if (bottom.GetArea())
+			m_FreeRects.push_back(bottom);
+
+		return true;
+	}
+
+	void AtlasPacker::Free(const AtlasRect& rect)
+	{
+		OE_CORE_ASSERT(m_UsedArea >= rect.GetArea(), "Freeing more than was inserted!");
+
+		m_UsedArea -= rect.GetArea();
+
+		// Merging can't always undo the splits, an empty page starts over
+		if (m_UsedArea == 0)
+		{
+			Clear();
+			return;
+		}
+
+		m_FreeRects.push_back(rect);
+		MergeFreeRects();
+	}
+
+	// Joins free rects sharing a whole side until no more pairs are found
+	void AtlasPacker::MergeFreeRects()
+	{
+		bool merged = true;
+		while (merged)
+		{
+			merged = false;
+
+			for (size_t i = 0; i < m_FreeRects.size() && !merged; i++)
+			{
+				for (size_t j = i + 1; j < m_FreeRects.size(); j++)
+				{
+					AtlasRect& a = m_FreeRects[i];
+					const AtlasRect& b = m_FreeRects[j];
+
+					if (a.X == b.X && a.Width == b.Width && (a.Y + a.Height == b.Y || b.Y + b.Height == a.Y))
+					{
+						a.Y = std::min(a.Y, b.Y);
+						a.Height += b.Height;
+					}
+					else if (a.Y == b.Y && a.Height == b.Height && (a.X + a.Width == b.X || b.X + b.Width == a.X))
+					{
+						a.X = std::min(a.X, b.X);
+						a.Width += b.Width;
+					}
+					else
+					{
+						continue;
+					}
+
+					m_FreeRects[j] = m_FreeRects.back();
+					m_FreeRects.pop_back();
+					merged = true;
+					break;
+				}
+			}
+		}
+	}
+
+	uint64_t AtlasPacker::GetLargestFreeArea() const
+	{
+		uint64_t largest = 0;
+		for (const auto& free : m_FreeRects)
+			largest = std::max(largest, free.GetArea());
+		return largest;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "OverEngine/Core/Core.h"
+
+namespace OverEngine
+{
+	struct AtlasRect
+	{
+		uint32_t X = 0, Y = 0;
+		uint32_t Width = 0, Height = 0;
+
+		inline uint64_t GetArea() const { return (uint64_t)Width * Height; }
+	};
+
+	/**
+	 * Incremental guillotine packer of one fixed size atlas page.
+	 * Inserting a rect never moves the placed ones, it takes the best fitting free rect and
+	 * splits the rest of it along the shorter leftover axis. Freed rects return to the
+	 * free list and are merged with neighbours sharing a whole side.
+	 */
+	class AtlasPacker
+	{
+	public:
+		AtlasPacker() = default;
+		AtlasPacker(uint32_t width, uint32_t height);
+
+		// Returns false if no free rect is big enough, position is set otherwise
+		bool Insert(uint32_t width, uint32_t height, AtlasRect& rect);
+		void Free(const AtlasRect& rect);
+
+		// Everything becomes free
+		void Clear();
+
+		inline uint32_t GetWidth() const { return m_Width; }
+		inline uint32_t GetHeight() const { return m_Height; }
+
+		inline uint64_t GetUsedArea() const { return m_UsedArea; }
+		inline float GetOccupancy() const { return m_Width && m_Height ? (float)m_UsedArea / ((float)m_Width * (float)m_Height) : 0.0f; }
+
+		// Biggest free rect area, how much the page could still take in one piece
+		uint64_t GetLargestFreeArea() const;
+	private:
+		void MergeFreeRects();
+	private:
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint64_t m_UsedArea = 0;
+
+		Vector<AtlasRect> m_FreeRects;
+	};
+}
@@ -5,6 +5,7 @@
 
 #include "OverEngine/Renderer/RendererAPI.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 namespace OverEngine
 {
@@ -14,6 +15,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>(vertices, size, staticDraw);
+		case RendererAPI::API::Null:    return CreateRef<NullVertexBuffer>(vertices, size, staticDraw);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -26,6 +28,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexBuffer>();
+		case RendererAPI::API::Null:    return CreateRef<NullVertexBuffer>();
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -38,6 +41,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLIndexBuffer>(indices, count, staticDraw);
+		case RendererAPI::API::Null:    return CreateRef<NullIndexBuffer>(indices, count, staticDraw);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -50,6 +54,59 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLIndexBuffer>();
+		case RendererAPI::API::Null:    return CreateRef<NullIndexBuffer>();
+		}
+
+		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<StreamingBuffer> StreamingBuffer::Create(uint32_t regionSize, uint32_t regionCount /*= 3*/)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLStreamingBuffer>(regionSize, regionCount);
+		case RendererAPI::API::Null:    return CreateRef<NullStreamingBuffer>(regionSize, regionCount);
+		}
+
+		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<PixelUnpackBuffer> PixelUnpackBuffer::Create(uint32_t regionSize, uint32_t regionCount /*= 3*/)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLPixelUnpackBuffer>(regionSize, regionCount);
+		case RendererAPI::API::Null:    return CreateRef<NullPixelUnpackBuffer>(regionSize, regionCount);
+		}
+
+		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<ShaderStorageBuffer> ShaderStorageBuffer::Create()
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShaderStorageBuffer>();
+		case RendererAPI::API::Null:    return CreateRef<NullShaderStorageBuffer>();
+		}
+
+		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size)
+	{
+		switch (RendererAPI::GetAPI())
+		{
+		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size);
+		case RendererAPI::API::Null:    return CreateRef<NullUniformBuffer>(size);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -4,7 +4,10 @@ namespace OverEngine
 {
 	enum class ShaderDataType
 	{
-		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+		None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+
+		// Packed types, read as floats when the element is normalized and as integers otherwise (except Half2)
+		UInt, UByte4, UShort2, Half2
 	};
 
 	static uint32_t ShaderDataTypeSize(ShaderDataType type)
@@ -22,6 +25,10 @@ namespace OverEngine
 		case ShaderDataType::Int3:     return 4 * 3;
 		case ShaderDataType::Int4:     return 4 * 4;
 		case ShaderDataType::Bool:     return 1;
+		case ShaderDataType::UInt:     return 4;
+		case ShaderDataType::UByte4:   return 1 * 4;
+		case ShaderDataType::UShort2:  return 2 * 2;
+		case ShaderDataType::Half2:    return 2 * 2;
 		}
 
 		OE_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -58,11 +65,33 @@ namespace OverEngine
 			case ShaderDataType::Int3:    return 3;
 			case ShaderDataType::Int4:    return 4;
 			case ShaderDataType::Bool:    return 1;
+			case ShaderDataType::UInt:    return 1;
+			case ShaderDataType::UByte4:  return 4;
+			case ShaderDataType::UShort2: return 2;
+			case ShaderDataType::Half2:   return 2;
 			}
 
 			OE_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			return 0;
 		}
+
+		// Reaches the shader as int / uint instead of being converted to float
+		bool IsInteger() const
+		{
+			switch (Type)
+			{
+			case ShaderDataType::Int:
+			case ShaderDataType::Int2:
+			case ShaderDataType::Int3:
+			case ShaderDataType::Int4:
+			case ShaderDataType::UInt:
+			case ShaderDataType::UByte4:
+			case ShaderDataType::UShort2:
+				return !Normalized;
+			default:
+				return false;
+			}
+		}
 	};
 
 	class BufferLayout
@@ -136,4 +165,100 @@ namespace OverEngine
 		static Ref<IndexBuffer> Create();
 		static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count, bool staticDraw = true);
 	};
+
+	/**
+	 * Vertex data which is rewritten every frame.
+	 * The buffer is split into RegionCount regions which are filled one after another.
+	 * Map returns memory to write into directly; the returned range must not be touched after Unmap.
+	 */
+	class StreamingBuffer
+	{
+	public:
+		virtual ~StreamingBuffer() = default;
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		/**
+		 * Reserves size bytes (size <= GetRegionSize()) whose offset is a multiple of alignment.
+		 * May block until the GPU stops reading the next region.
+		 */
+		virtual void* Map(uint32_t size, uint32_t alignment = 1) = 0;
+		virtual void Unmap() = 0;
+
+		// Offset of the last mapped range in bytes, used as base vertex / base instance
+		virtual uint32_t GetMappedOffset() const = 0;
+
+		virtual uint32_t GetRegionSize() const = 0;
+		virtual uint32_t GetRegionCount() const = 0;
+		virtual bool IsPersistentlyMapped() const = 0;
+
+		virtual const BufferLayout& GetLayout() const = 0;
+		virtual void SetLayout(const BufferLayout& layout) = 0;
+
+		static Ref<StreamingBuffer> Create(uint32_t regionSize, uint32_t regionCount = 3);
+	};
+
+	/**
+	 * Staging memory textures copy their pixels from on the GPU timeline, see GAPI::Texture2D::SubImage.
+	 * Like StreamingBuffer it is split into RegionCount regions, one is filled per NextRegion call.
+	 */
+	class PixelUnpackBuffer
+	{
+	public:
+		virtual ~PixelUnpackBuffer() = default;
+
+		virtual void Bind() const = 0;
+		virtual void Unbind() const = 0;
+
+		// Reserves size bytes of the current region, nullptr if it doesn't have that much left
+		virtual void* Map(uint32_t size) = 0;
+		virtual void Unmap() = 0;
+
+		// Offset of the last mapped range in bytes
+		virtual uint32_t GetMappedOffset() const = 0;
+
+		// Starts filling the next region, may block until the GPU stops reading it
+		virtual void NextRegion() = 0;
+
+		virtual uint32_t GetRegionSize() const = 0;
+		virtual uint32_t GetRegionCount() const = 0;
+
+		static Ref<PixelUnpackBuffer> Create(uint32_t regionSize, uint32_t regionCount = 3);
+	};
+
+	/**
+	 * Read-only structured data for shaders (std430 layout on OpenGL)
+	 */
+	class ShaderStorageBuffer
+	{
+	public:
+		virtual ~ShaderStorageBuffer() = default;
+
+		virtual void Bind(uint32_t binding) const = 0;
+
+		virtual void BufferSubData(const void* data, uint32_t size, uint32_t offset = 0) const = 0;
+		virtual void AllocateStorage(uint32_t size) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		static Ref<ShaderStorageBuffer> Create();
+	};
+
+	/**
+	 * Small block of shader constants (std140 layout on OpenGL), e.g. camera matrices
+	 */
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() = default;
+
+		virtual void Bind(uint32_t binding) const = 0;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) const = 0;
+
+		virtual uint32_t GetSize() const = 0;
+
+		static Ref<UniformBuffer> Create(uint32_t size);
+	};
 }
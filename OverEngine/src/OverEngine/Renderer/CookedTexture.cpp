@@ -0,0 +1,238 @@
+#include "pcheader.h"
+#include "CookedTexture.h"
+
+#include "OverEngine/Renderer/TextureManager.h"
+#include "OverEngine/Core/FileSystem/FileSystem.h"
+#include "OverEngine/Core/Extentions.h"
+
+#include <stb_image.h>
+#include <fstream>
+
+namespace OverEngine
+{
+	static constexpr char s_CookedTextureMagic[4] = { 'O', 'E', 'T', 'X' };
+	static constexpr uint32_t s_CookedTextureVersion = 2;
+
+	static uint32_t GetLevelSize(uint32_t size, uint32_t level)
+	{
+		return std::max(size >> level, 1u);
+	}
+
+	/////////////////////////////////////////////////////////
+	// CookedTexture ////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	Ref<CookedTexture> CookedTexture::Open(const String& path)
+	{
+		Ref<CookedTexture> cooked = CreateRef<CookedTexture>();
+		auto& file = cooked->m_File;
+
+		if (!file.Open(path) || file.GetSize() < sizeof(CookedTextureHeader))
+		{
+			OE_CORE_ERROR("Failed to open cooked texture '{0}'!", path);
+			return nullptr;
+		}
+
+		const auto* header = (const CookedTextureHeader*)file.GetData();
+		if (memcmp(header->Magic, s_CookedTextureMagic, sizeof(s_CookedTextureMagic)) != 0 || header->Version != s_CookedTextureVersion ||
+			header->Encoding != CookedTextureEncoding::RGBA8 || header->Channels == 0 || header->Channels > 4 ||
+			header->MipLevelCount == 0 || header->Width == 0 || header->Height == 0 ||
+			header->PaddedWidth < header->Width + 2 * header->Gutter || header->PaddedHeight < header->Height + 2 * header->Gutter)
+		{
+			OE_CORE_ERROR("'{0}' is not a valid cooked texture!", path);
+			return nullptr;
+		}
+
+		size_t offset = sizeof(CookedTextureHeader);
+		for (uint32_t level = 0; level < header->MipLevelCount; level++)
+		{
+			cooked->m_LevelOffsets.push_back(offset);
+			offset += (size_t)GetLevelSize(header->PaddedWidth, level) * GetLevelSize(header->PaddedHeight, level) * 4;
+		}
+
+		if (offset > file.GetSize())
+		{
+			OE_CORE_ERROR("Cooked texture '{0}' is truncated!", path);
+			return nullptr;
+		}
+
+		cooked->m_Header = header;
+		return cooked;
+	}
+
+	uint32_t CookedTexture::GetLevelWidth(uint32_t level) const { return GetLevelSize(m_Header->PaddedWidth, level); }
+	uint32_t CookedTexture::GetLevelHeight(uint32_t level) const { return GetLevelSize(m_Header->PaddedHeight, level); }
+
+	const uint8_t* CookedTexture::GetLevel(uint32_t level) const
+	{
+		OE_CORE_ASSERT(level < m_Header->MipLevelCount, "Cooked texture has no such mip level!");
+		return m_File.GetData() + m_LevelOffsets[level];
+	}
+
+	// Grey images (1 channel) have no alpha either, grey + alpha (2 channels) does
+	TextureFormat CookedTexture::GetSourceFormat() const
+	{
+		return m_Header->Channels % 2 == 1 ? TextureFormat::RGB : TextureFormat::RGBA;
+	}
+
+	void CookedTexture::CopySourcePixels(uint8_t* pixels, TextureFormat format) const
+	{
+		const auto& header = *m_Header;
+		const uint8_t* level = GetLevel(0);
+
+		for (uint32_t row = 0; row < header.Height; row++)
+		{
+			const uint8_t* source = level + ((size_t)(row + header.Gutter) * header.PaddedWidth + header.Gutter) * 4;
+			if (format == TextureFormat::RGBA)
+			{
+				memcpy(pixels + (size_t)row * header.Width * 4, source, (size_t)header.Width * 4);
+				continue;
+			}
+
+			uint8_t* destination = pixels + (size_t)row * header.Width * 3;
+			for (uint32_t column = 0; column < header.Width; column++)
+				memcpy(destination + (size_t)column * 3, source + (size_t)column * 4, 3);
+		}
+	}
+
+	/////////////////////////////////////////////////////////
+	// TextureCooker ////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	String TextureCooker::GetCookedPath(const String& sourcePath)
+	{
+		return sourcePath + "." OE_COOKED_TEXTURE_FILE_EXTENSION;
+	}
+
+	bool TextureCooker::IsCookedUpToDate(const String& sourcePath, const String& cookedPath)
+	{
+		std::error_code error;
+		auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+		if (error)
+			return false;
+
+		auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+		if (error || cookedTime < sourceTime)
+			return false;
+
+		// Files cooked by an older version are cooked again
+		CookedTextureHeader header;
+		std::ifstream file(cookedPath, std::ios::in | std::ios::binary);
+		return file.read((char*)&header, sizeof(header)) && header.Version == s_CookedTextureVersion;
+	}
+
+	bool TextureCooker::Cook(const String& sourcePath, const String& cookedPath, uint32_t gutter, bool mipmaps /*= true*/)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(0);
+		stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+
+		if (!pixels)
+		{
+			OE_CORE_ERROR("Failed to load image '{0}'!", sourcePath);
+			return false;
+		}
+
+		CookedTextureHeader header;
+		memcpy(header.Magic, s_CookedTextureMagic, sizeof(s_CookedTextureMagic));
+		header.Version = s_CookedTextureVersion;
+		header.Width = (uint32_t)width;
+		header.Height = (uint32_t)height;
+		header.Channels = (uint32_t)channels;
+		header.Gutter = gutter;
+		header.MipLevelCount = mipmaps ? TextureManager::GetPackedMipLevelCount(gutter) : 1;
+		header.PaddedWidth = TextureManager::GetPackedSize(header.Width, gutter, header.MipLevelCount);
+		header.PaddedHeight = TextureManager::GetPackedSize(header.Height, gutter, header.MipLevelCount);
+		header.Encoding = CookedTextureEncoding::RGBA8;
+
+		// Level 0, the alignment padding past the gutter is extruded too
+		Vector<uint8_t> level((size_t)header.PaddedWidth * header.PaddedHeight * 4);
+		for (uint32_t row = 0; row < header.PaddedHeight; row++)
+		{
+			uint32_t sourceRow = (uint32_t)std::clamp((int)row - (int)gutter, 0, height - 1);
+			for (uint32_t column = 0; column < header.PaddedWidth; column++)
+			{
+				uint32_t sourceColumn = (uint32_t)std::clamp((int)column - (int)gutter, 0, width - 1);
+				memcpy(&level[((size_t)row * header.PaddedWidth + column) * 4], pixels + ((size_t)sourceRow * width + sourceColumn) * 4, 4);
+			}
+		}
+
+		stbi_image_free(pixels);
+
+		// Written aside and renamed over, textures may have the old file mapped
+		String temporaryPath = cookedPath + ".tmp";
+		std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			OE_CORE_ERROR("Could not create cooked texture '{0}'!", cookedPath);
+			return false;
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)level.data(), level.size());
+
+		// Padded sizes are multiples of the coarsest level texel, each level halves exactly
+		for (uint32_t l = 1; l < header.MipLevelCount; l++)
+		{
+			uint32_t levelWidth = GetLevelSize(header.PaddedWidth, l);
+			uint32_t levelHeight = GetLevelSize(header.PaddedHeight, l);
+			uint32_t previousWidth = GetLevelSize(header.PaddedWidth, l - 1);
+
+			Vector<uint8_t> next((size_t)levelWidth * levelHeight * 4);
+			for (uint32_t row = 0; row < levelHeight; row++)
+			{
+				for (uint32_t column = 0; column < levelWidth; column++)
+				{
+					const uint8_t* topLeft = &level[((size_t)row * 2 * previousWidth + column * 2) * 4];
+					const uint8_t* bottomLeft = topLeft + (size_t)previousWidth * 4;
+
+					for (uint32_t c = 0; c < 4; c++)
+						next[((size_t)row * levelWidth + column) * 4 + c] = (uint8_t)((topLeft[c] + topLeft[4 + c] + bottomLeft[c] + bottomLeft[4 + c] + 2) / 4);
+				}
+			}
+
+			file.write((const char*)next.data(), next.size());
+			level = std::move(next);
+		}
+
+		file.close();
+
+		std::error_code error;
+		if (!file.fail())
+			std::filesystem::rename(temporaryPath, cookedPath, error);
+
+		if (file.fail() || error)
+		{
+			OE_CORE_ERROR("Could not write cooked texture '{0}'!", cookedPath);
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+	uint32_t TextureCooker::CookDirectory(const String& directory, uint32_t gutter, bool mipmaps /*= true*/)
+	{
+		static const std::unordered_set<String> imageExtentions = { "png", "jpg", "jpeg", "tga", "bmp" };
+
+		uint32_t cookedCount = 0;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			if (!entry.is_regular_file())
+				continue;
+
+			auto path = entry.path().string();
+			auto extention = FileSystem::ExtractFileExtentionFromPath(path);
+			std::transform(extention.begin(), extention.end(), extention.begin(), [](char c) { return (char)std::tolower(c); });
+
+			if (!imageExtentions.count(extention))
+				continue;
+
+			auto cookedPath = GetCookedPath(path);
+			if (!IsCookedUpToDate(path, cookedPath) && Cook(path, cookedPath, gutter, mipmaps))
+				cookedCount++;
+		}
+
+		return cookedCount;
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "OverEngine/Core/Core.h"
+#include "OverEngine/Core/FileSystem/MappedFile.h"
+#include "OverEngine/Renderer/TextureEnums.h"
+
+namespace OverEngine
+{
+	// Atlases are RGBA8, block compressed levels couldn't be packed into them
+	enum class CookedTextureEncoding : uint32_t { RGBA8 = 0 };
+
+	/**
+	 * Start of a .oetex file, followed by the mip levels largest first, rows tightly packed.
+	 * Level 0 is the source image surrounded by Gutter extruded texels and padded like
+	 * TextureManager packs it (see TextureManager::GetPackedSize), level n is 2^n times smaller.
+	 */
+	struct CookedTextureHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+
+		uint32_t Width, Height; // Source image
+		uint32_t Channels; // Of the source image, levels are RGBA8 regardless
+		uint32_t Gutter;
+		uint32_t PaddedWidth, PaddedHeight; // Level 0
+		uint32_t MipLevelCount;
+		CookedTextureEncoding Encoding;
+	};
+
+	// A .oetex file mapped to memory, levels are uploaded straight from the mapping
+	class CookedTexture
+	{
+	public:
+		// nullptr if path isn't a valid cooked texture
+		static Ref<CookedTexture> Open(const String& path);
+
+		inline const CookedTextureHeader& GetHeader() const { return *m_Header; }
+
+		uint32_t GetLevelWidth(uint32_t level) const;
+		uint32_t GetLevelHeight(uint32_t level) const;
+		const uint8_t* GetLevel(uint32_t level) const;
+
+		// RGB for source images without alpha, so they aren't drawn as transparent
+		TextureFormat GetSourceFormat() const;
+
+		// Copies the source image out of level 0 (gutter left out), Width * Height texels of format
+		void CopySourcePixels(uint8_t* pixels, TextureFormat format) const;
+	private:
+		MappedFile m_File;
+		const CookedTextureHeader* m_Header = nullptr;
+		Vector<size_t> m_LevelOffsets;
+	};
+
+	class TextureCooker
+	{
+	public:
+		// Cooked files sit next to their source: "Player.png" -> "Player.png.oetex"
+		static String GetCookedPath(const String& sourcePath);
+
+		// cookedPath exists, isn't older than sourcePath and was cooked by this version
+		static bool IsCookedUpToDate(const String& sourcePath, const String& cookedPath);
+
+		// Decodes sourcePath and writes it laid out for atlases packed with gutter, mip levels box filtered
+		static bool Cook(const String& sourcePath, const String& cookedPath, uint32_t gutter, bool mipmaps = true);
+
+		// Cooks every image under directory missing an up to date cooked file, returns how many were written
+		static uint32_t CookDirectory(const String& directory, uint32_t gutter, bool mipmaps = true);
+	};
+}
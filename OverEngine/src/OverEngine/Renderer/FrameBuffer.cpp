@@ -5,6 +5,7 @@
 
 #include "OverEngine/Renderer/RendererAPI.h"
 #include "Platform/OpenGL/OpenGLFrameBuffer.h"
+#include "Platform/Null/NullFrameBuffer.h"
 
 namespace OverEngine
 {
@@ -15,6 +16,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLFrameBuffer>(props);
+		case RendererAPI::API::Null:    return CreateRef<NullFrameBuffer>(props);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
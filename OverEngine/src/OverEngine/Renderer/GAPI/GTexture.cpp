@@ -3,6 +3,7 @@
 
 #include "OverEngine/Renderer/RendererAPI.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
 
 namespace OverEngine
 {
@@ -14,6 +15,7 @@ namespace OverEngine
 			{
 			case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path, minFilter, magFilter);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>(path, minFilter, magFilter);
 			}
 
 			OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -26,6 +28,20 @@ namespace OverEngine
 			{
 			case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>();
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2D>();
+			}
+
+			OE_CORE_ASSERT(false, "Unknown RendererAPI!");
+			return nullptr;
+		}
+
+		Ref<Texture2DArray> Texture2DArray::Create(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels /*= 1*/)
+		{
+			switch (RendererAPI::GetAPI())
+			{
+			case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2DArray>(format, width, height, mipLevels);
+			case RendererAPI::API::Null:    return CreateRef<NullTexture2DArray>(format, width, height, mipLevels);
 			}
 
 			OE_CORE_ASSERT(false, "Unknown RendererAPI!");
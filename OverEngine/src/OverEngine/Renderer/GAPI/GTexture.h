@@ -6,6 +6,7 @@
 namespace OverEngine
 {
 	class Texture2D;
+	class PixelUnpackBuffer;
 
 	namespace GAPI
 	{
@@ -45,10 +46,41 @@ namespace OverEngine
 			static Ref<Texture2D> Create(const String& path, TextureFiltering minFilter = TextureFiltering::Linear, TextureFiltering magFilter = TextureFiltering::Linear);
 			static Ref<Texture2D> Create();
 
-			virtual void AllocateStorage(TextureFormat format, uint32_t width, uint32_t height) = 0;
-			virtual void SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0) = 0;
+			virtual void AllocateStorage(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels = 1) = 0;
+			virtual void SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0, uint32_t level = 0) = 0;
 
-			virtual Vector<Ref<::OverEngine::Texture2D>>& GetMemberTextures() = 0;
+			// Copies from offset of buffer on the GPU timeline, the range must not be rewritten until the copy is done
+			virtual void SubImage(const PixelUnpackBuffer& buffer, uint32_t offset, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0) = 0;
+
+			// Copies level 0 texels of source on the GPU, both must have the same format
+			virtual void CopySubImage(const Texture2D& source, int sourceX, int sourceY, uint32_t width, uint32_t height, int xOffset = 0, int yOffset = 0) = 0;
+
+			// Fills levels 1 -> n from level 0, no-op for single level storage
+			virtual void GenerateMipmaps() = 0;
+			virtual uint32_t GetMipLevelCount() const = 0;
+
+			// Layer of the Texture2DArray this texture is a view of, -1 for standalone textures
+			virtual int GetArrayLayer() const = 0;
+
+			// Textures packed in this atlas, not owned; they remove themselves when destroyed
+			virtual Vector<::OverEngine::Texture2D*>& GetMemberTextures() = 0;
+		};
+
+		/**
+		 * Equally sized layers sampled through a single binding. Each layer is
+		 * also a Texture2D view sharing the storage, usable wherever a Texture2D is.
+		 */
+		class Texture2DArray : public Texture
+		{
+		public:
+			static Ref<Texture2DArray> Create(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels = 1);
+
+			// Reallocates the storage, contents and views of the kept layers stay valid
+			virtual void SetLayerCount(uint32_t layerCount) = 0;
+			virtual uint32_t GetLayerCount() const = 0;
+			virtual uint32_t GetMipLevelCount() const = 0;
+
+			virtual const Ref<Texture2D>& GetLayer(uint32_t layer) const = 0;
 		};
 	}
 
@@ -2,6 +2,7 @@
 #include "RenderCommand.h"
 
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 
 namespace OverEngine
 {
@@ -11,14 +12,28 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return new OpenGLRendererAPI();
+		case RendererAPI::API::Null:    return new NullRendererAPI();
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
-	RendererAPI* RenderCommand::s_RendererAPI = CreateRendererAPI();
+	RendererAPI* RenderCommand::s_RendererAPI = nullptr;
 
 	uint32_t RenderCommand::s_MaxTextureSize = 0;
 	uint32_t RenderCommand::s_MaxTextureSlotCount = 0;
+	uint32_t RenderCommand::s_MaxArrayTextureLayers = 0;
+
+	// Created here rather than statically so the API can be chosen at runtime
+	void RenderCommand::Init()
+	{
+		delete s_RendererAPI;
+		s_RendererAPI = CreateRendererAPI();
+		s_RendererAPI->Init();
+
+		s_MaxTextureSize = s_RendererAPI->GetMaxTextureSize();
+		s_MaxTextureSlotCount = s_RendererAPI->GetMaxTextureSlotCount();
+		s_MaxArrayTextureLayers = s_RendererAPI->GetMaxArrayTextureLayers();
+	}
 }
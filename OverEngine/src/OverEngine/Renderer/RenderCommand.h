@@ -7,13 +7,7 @@ namespace OverEngine
 	class RenderCommand
 	{
 	public:
-		inline static void Init()
-		{
-			s_RendererAPI->Init();
-
-			s_MaxTextureSize = s_RendererAPI->GetMaxTextureSize();
-			s_MaxTextureSlotCount = s_RendererAPI->GetMaxTextureSlotCount();
-		}
+		static void Init();
 
 		inline static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 		{
@@ -35,9 +29,54 @@ namespace OverEngine
 			s_RendererAPI->Clear(flags);
 		}
 
-		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0)
+		inline static void SetBlendMode(BlendMode mode)
+		{
+			s_RendererAPI->SetBlendMode(mode);
+		}
+
+		inline static void BeginSampleCount()
+		{
+			s_RendererAPI->BeginSampleCount();
+		}
+
+		inline static uint64_t EndSampleCount()
+		{
+			return s_RendererAPI->EndSampleCount();
+		}
+
+		inline static void NextGPUTimerFrame()
+		{
+			s_RendererAPI->NextGPUTimerFrame();
+		}
+
+		inline static void BeginGPUTimer(uint32_t view = 0)
+		{
+			s_RendererAPI->BeginGPUTimer(view);
+		}
+
+		inline static void EndGPUTimer()
 		{
-			s_RendererAPI->DrawIndexed(vertexArray, indexCount);
+			s_RendererAPI->EndGPUTimer();
+		}
+
+		inline static uint64_t GetGPUFrameTime()
+		{
+			return s_RendererAPI->GetGPUFrameTime();
+		}
+
+		inline static uint64_t GetGPUViewTime(uint32_t view)
+		{
+			return s_RendererAPI->GetGPUViewTime(view);
+		}
+
+		inline static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0)
+		{
+			s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
+		}
+
+		inline static void DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance = 0)
+		{
+			s_RendererAPI->DrawInstanced(vertexArray, vertexCount, instanceCount, baseInstance);
 		}
 
 		inline static uint32_t GetMaxTextureSize()
@@ -49,10 +88,21 @@ namespace OverEngine
 		{
 			return s_MaxTextureSlotCount;
 		}
+
+		inline static uint32_t GetMaxArrayTextureLayers()
+		{
+			return s_MaxArrayTextureLayers;
+		}
+
+		inline static uint32_t GetElidedCallCount()
+		{
+			return s_RendererAPI->GetElidedCallCount();
+		}
 	private:
 		static RendererAPI* s_RendererAPI;
 
 		static uint32_t s_MaxTextureSize;
 		static uint32_t s_MaxTextureSlotCount;
+		static uint32_t s_MaxArrayTextureLayers;
 	};
 }
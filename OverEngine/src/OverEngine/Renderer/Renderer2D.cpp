@@ -2,50 +2,225 @@
 #include "Renderer2D.h"
 
 #include "Texture.h"
+#include "TextureManager.h"
+#include "Renderer2DCapture.h"
+
+#include "OverEngine/Core/Time/Time.h"
+
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define OE_RENDERER2D_SSE 1
+	#include <xmmintrin.h>
+#else
+	#define OE_RENDERER2D_SSE 0
+#endif
 
 namespace OverEngine
 {
 	Renderer2D::Statistics Renderer2D::s_Statistics;
 
+	/**
+	 * 24 bytes; the UVs come from the descriptor's TexCoordRange, so a vertex only
+	 * stores which corner of that range it is at (as 16 bit UNorm).
+	 */
 	struct Vertex
 	{
-		Vector4 a_Position = Vector4(0.0f);
-		Color a_Color = Color(0.0f);
-
-		float a_TexSlot                   = -1.0f;
-		float a_TexFilter                 = 0.0f;
-		float a_TexAlphaClippingThreshold = 0.0f;
-		Vector2 a_TexWrapping             = Vector2(0.0f);
-		Color a_TexBorderColor            = Color(0.0f);
-		Rect a_TexRect                    = Rect(0.0f);
-		Vector2 a_TexSize                 = Vector2(0.0f);
-		Vector2 a_TexCoord                = Vector2(0.0f);
-		Rect a_TexCoordRange              = Vector4(0.0f);
+		Vector3 a_Position = Vector3(0.0f); // World space, projected by the camera uniform buffer
+		uint32_t a_Color = 0; // RGBA8
+
+		uint32_t a_TexDescriptor = 0; // Descriptor index | (Slot + 1) << 24 (Slot is patched on Flush), 0 for untextured quads
+		Vec2T<uint16_t> a_TexCorner{ 0, 0 }; // 0 or 0xFFFF, min or max corner of TexCoordRange
 	};
 
+	static_assert(sizeof(Vertex) == 24, "Vertex must stay tightly packed");
+
 	using DrawQuadVertices = std::array<Vertex, 4>;
 	using DrawQuadIndices = std::array<uint32_t, 6>;
 
+	/**
+	 * Compact per quad record used by instanced rendering (44 bytes instead of 4 * 24).
+	 * Corners and UVs are generated in the vertex shader from gl_VertexID.
+	 */
+	struct InstanceVertex
+	{
+		Vector3 a_TransformX = Vector3(0.0f);
+		Vector3 a_TransformY = Vector3(0.0f);
+		Vector3 a_TransformW = Vector3(0.0f);
+		uint32_t a_Color = 0;
+
+		uint32_t a_TexDescriptor = 0; // Same packing as Vertex::a_TexDescriptor
+	};
+
+	/**
+	 * Sampling state of one (texture, overrides) combination.
+	 * Mirrored to a shader storage buffer (std430) and referenced by a 24 bit index from each quad.
+	 */
+	struct TextureDescriptor
+	{
+		Rect TexRect                    = Rect(0.0f);
+		Color TexBorderColor            = Color(0.0f);
+		Rect TexCoordRange              = Rect(0.0f);
+		Vector2 TexSize                 = Vector2(0.0f);
+		float TexAlphaClippingThreshold = 0.0f;
+		uint32_t TexParams              = 0; // Filter | SWrapping << 4 | TWrapping << 8 | HardwareSampling << 12 | Page layer << 16
+	};
+
+	// CPU side bookkeeping of a TextureDescriptor
+	struct TextureDescriptorEntry
+	{
+		std::weak_ptr<Texture2D> Texture;
+		uint32_t Revision = 0;
+		TexturedQuadExtraData Overrides;
+
+		Ref<GAPI::Texture2D> GPUTexture = nullptr;
+		uint32_t GPUTextureID = 0;
+		bool HasAlpha = false; // Texture or sampled border isn't opaque, picks the quad pass
+		uint32_t ShaderFlags = 0; // BatchShaderFlags of the quads using the descriptor
+	};
+
+	// Slot assignment of a GPU texture, stored in a flat array indexed by its renderer ID
+	struct TextureBindState
+	{
+		GAPI::Texture2D* Texture = nullptr;
+		uint32_t PendingStamp = 0; // Texture is referenced by pending quads if equal to Renderer2DData::PendingStamp
+		uint32_t BatchStamp = 0; // Slot is valid if equal to the stamp of the batch being built
+		uint32_t Slot = 0;
+		bool Paged = false; // Layer of TextureManager's pages, needs no slot
+	};
+
+	/**
+	 * Fragment paths needed by the quads of a batch. The batch is drawn with the shader
+	 * permutation covering all of them, see GetBatchShader. Together with Paged and
+	 * Instanced the flags index the permutation.
+	 */
+	enum BatchShaderFlags : uint32_t
+	{
+		BatchShader_PointClamp  = 1 << 0, // Hardware sampled with Nearest filtering
+		BatchShader_LinearClamp = 1 << 1, // Hardware sampled with Linear filtering
+		BatchShader_Emulated    = 1 << 2, // Wrapping or filtering emulated in the shader
+		BatchShader_AlphaClip   = 1 << 3, // Can drop to the alpha clipping threshold
+		BatchShader_Paged       = 1 << 4,
+		BatchShader_Instanced   = 1 << 5,
+
+		BatchShader_SamplingMask = BatchShader_PointClamp | BatchShader_LinearClamp | BatchShader_Emulated,
+		BatchShader_Generic = BatchShader_Emulated | BatchShader_AlphaClip, // Every path is picked per fragment
+		BatchShader_PermutationCount = 1 << 6
+	};
+
+	// Contiguous range of sorted quads drawn with one draw call and one set of bound textures
+	struct QuadBatch
+	{
+		uint32_t FirstQuad = 0;
+		uint32_t QuadCount = 0;
+		uint32_t FirstTexture = 0; // Into Renderer2DData::BatchTextures
+		uint32_t TextureCount = 0;
+		uint32_t Pass = 0; // QuadPass of every quad in the batch
+		bool Paged = false; // Textures are sampled from TextureManager's pages instead of slots
+		uint32_t ShaderFlags = 0; // Union of the BatchShaderFlags of its quads
+	};
+
+	enum QuadPass : uint32_t
+	{
+		QuadPass_Opaque = 0,
+		QuadPass_AlphaClip, // Cutout sprites in early depth mode, see Renderer2D::SetEarlyDepth
+		QuadPass_Transparent
+	};
+
+	/**
+	 * Every submitted quad is appended to an unsorted list and tagged with a 64 bit key.
+	 * Flush radix sorts the keys once and emits vertices in key order.
+	 *
+	 * Key layout (most significant bit first):
+	 *   [63 - 62] Pass     : QuadPass
+	 *   [61 - 30] Depth    : Sortable view depth, front to back for the depth writing passes, back to front for Transparent
+	 *   [29 -  0] Sequence : Submission index (reversed for the depth writing passes)
+	 */
+	struct QuadSortEntry
+	{
+		uint64_t Key;
+		uint32_t Index;
+	};
+
+	// Contents of the camera uniform buffer (std140)
+	struct CameraData
+	{
+		Mat4x4 ViewProjection;
+	};
+
+	struct RetainedQuadBatchData;
+
 	struct Renderer2DData
 	{
 		Ref<VertexArray> vertexArray = nullptr;
-		Ref<VertexBuffer> vertexBuffer = nullptr;
+		Ref<StreamingBuffer> vertexStream = nullptr;
 		Ref<IndexBuffer> indexBuffer = nullptr;
 
 		Vector<DrawQuadVertices> Vertices;
 		Vector<DrawQuadIndices> Indices;
-		Vector<float> QuadsZIndices;
+
+		Ref<VertexArray> instanceVertexArray = nullptr;
+		Ref<StreamingBuffer> instanceStream = nullptr;
+
+		Vector<InstanceVertex> Instances;
+
+		uint32_t InstanceCapacity;
+		bool InstancedRendering = false;
+
+		Vector<QuadSortEntry> SortEntries;
+		Vector<QuadSortEntry> SortScratch;
 
 		uint32_t QuadCapacity;
 		uint32_t FlushingQuadCount;
 
-		uint32_t OpaqueInsertIndex = 0;
+		double SubmitStart = 0.0; // End of the last flush, DrawQuad calls since then are submission time
+
+		// Indexed by BatchShaderFlags, compiled on first use
+		ShaderLibrary BatchShaderPermutations;
+		std::array<Ref<Shader>, BatchShader_PermutationCount> BatchShaders;
+
+		Ref<ShaderStorageBuffer> textureDescriptorBuffer = nullptr;
+		Ref<UniformBuffer> cameraBuffer = nullptr;
 
-		Ref<Shader> BatchRenderer2DShader = nullptr;
+		Vector<TextureDescriptor> TextureDescriptors;
+		Vector<TextureDescriptorEntry> TextureDescriptorEntries;
+		UnorderedMap<const Texture2D*, Vector<uint32_t>> TextureDescriptorLookup; // Newest last, at most MaxDescriptorsPerTexture
+		uint32_t TextureDescriptorBaseline = 0; // Table size one geometry after the last clear, what is actually in use
+		bool TextureDescriptorsCleared = false;
 
-		UnorderedMap<uint32_t, Ref<GAPI::Texture2D>> TextureBindList;
+		uint32_t TextureDescriptorsDirtyBegin = 0;
+		uint32_t TextureDescriptorsDirtyEnd = 0;
 
-		Mat4x4 ViewProjectionMatrix;
+		Vector<uint32_t> QuadTextureIDs; // GPU texture of each pending quad, 0 for untextured quads
+		Vector<Ref<GAPI::Texture2D>> PendingTextures;
+		Vector<TextureBindState> TextureBindStates;
+		uint32_t PendingStamp = 1;
+		uint32_t BatchStamp = 0;
+
+		Vector<QuadBatch> Batches;
+		Vector<GAPI::Texture2D*> BatchTextures;
+
+		Vector<RetainedQuadBatchData*> RetainedBatches; // Drawn before the immediate quads
+		uint32_t TextureDescriptorEpoch = 0; // Incremented when the descriptor table is cleared
+
+		// Built geometry; stays drawable until the next Reset
+		bool GeometryInstanced = false;
+		uint32_t GeometryBase = 0; // Base vertex or base instance of the built quads in the stream
+
+		Mat4x4 ViewProjectionMatrix = IDENTITY_MAT4X4;
+		bool HasCamera = true; // False while recording camera independent geometry
+
+		uint32_t View = 0; // Index of the current view in the frame, picks its GPU timer
+
+		/**
+		 * View depth of a world position p is dot(SortDepthZ, p) / dot(SortDepthW, p) (rows 2 and 3 of the view projection).
+		 * Without a camera it falls back to -z, a camera looking down -Z.
+		 */
+		Vector4 SortDepthZ = Vector4(0.0f, 0.0f, -1.0f, 0.0f);
+		Vector4 SortDepthW = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+
+		bool EarlyDepth = false;
+		bool OverdrawDebug = false;
 
 		static constexpr float QuadVertices[3 * 4] = {
 			-0.5f, -0.5f, 0.0f,
@@ -62,354 +237,1625 @@ namespace OverEngine
 			16, 17, 18, 19, 20, 21, 22, 23,
 			24, 25, 26, 27, 28, 29, 30, 31
 		};
+
+		// Regions of the streaming buffers, a region is reused once the GPU is done with it
+		static constexpr uint32_t StreamRegionCount = 3;
+
+		static constexpr uint32_t MaxTextureSlots = 32; // Size of u_Slots
+		static constexpr uint32_t TextureSlotShift = 24; // Descriptor index in the low bits of a_TexDescriptor, slot + 1 above
+		static constexpr uint32_t MaxTextureDescriptors = 1 << TextureSlotShift;
+		static constexpr uint32_t InvalidTextureDescriptor = UINT32_MAX;
+		static constexpr uint32_t MaxDescriptorsPerTexture = 16; // Older ones are only forgotten by the lookup, quads keep using them
+		static constexpr uint32_t MinRecycledDescriptors = 1024; // Growth over twice the baseline which clears the table
+		static constexpr uint32_t TextureDescriptorsBinding = 0;
+		static constexpr uint32_t CameraBinding = 0;
+
+		static constexpr uint32_t SortKeyPassShift = 62;
+		static constexpr uint32_t SortKeyDepthShift = 30;
+		static constexpr uint64_t SortKeySequenceMask = ((uint64_t)1 << 30) - 1;
 	};
 
 	static Renderer2DData* s_Data;
 
-	static void InsertVertices(bool transparent, const float& z, const DrawQuadVertices& vertices)
+	// Maps a float to an unsigned integer which keeps the ordering of the float values
+	static uint32_t FloatToSortableUInt(float value)
 	{
-		if (transparent)
-		{
-			for (auto idx = s_Data->Vertices.begin() + s_Data->OpaqueInsertIndex; idx < s_Data->Vertices.end(); idx++)
-			{
-				auto i = idx - s_Data->Vertices.begin();
-				if (z < s_Data->QuadsZIndices[i])
-				{
-					s_Data->Vertices.emplace(idx, vertices);
-					s_Data->QuadsZIndices.emplace(s_Data->QuadsZIndices.begin() + i, z);
-					return;
-				}
-			}
-
-			s_Data->Vertices.emplace_back(vertices);
-			s_Data->QuadsZIndices.emplace_back(z);
-			return;
-		}
+		if (value == 0.0f) // -0.0f and 0.0f should be equal
+			value = 0.0f;
 
-		// Opaque
-		s_Data->Vertices.emplace(s_Data->Vertices.begin(), vertices);
-		s_Data->QuadsZIndices.emplace(s_Data->QuadsZIndices.begin(), z);
-		s_Data->OpaqueInsertIndex++;
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
 	}
 
-	static void GenIndices(uint32_t quadCount, uint32_t indexCount)
+	static uint32_t PackColor(const Color& color)
 	{
-		// Allocate storage on GPU memory
-		s_Data->indexBuffer->AllocateStorage(indexCount);
-
-		s_Data->Indices.reserve(quadCount);
-		for (uint32_t i = (uint32_t)s_Data->Indices.size(); i < quadCount; i++)
-		{
-			// Generate indices
-			DrawQuadIndices indices;
-			for (uint32_t j = 0; j < 6; j++)
-				indices[j] = Renderer2DData::QuadIndices[j] + 4 * i;
-			s_Data->Indices.push_back(indices);
-		}
-
-		// Upload data to GPU
-		s_Data->indexBuffer->BufferSubData((uint32_t*)s_Data->Indices.data(), indexCount);
+		auto toByte = [](float value) { return (uint32_t)(Math::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+		return toByte(color.r) | toByte(color.g) << 8 | toByte(color.b) << 16 | toByte(color.a) << 24;
 	}
 
-	void Renderer2D::Init(uint32_t initQuadCapacity)
+	static Color UnpackColor(uint32_t color)
 	{
-		s_Data = new Renderer2DData();
-
-		s_Data->vertexArray = VertexArray::Create();
-		s_Data->QuadCapacity = initQuadCapacity;
-
-		s_Data->vertexBuffer = VertexBuffer::Create();
-		s_Data->vertexBuffer->AllocateStorage(initQuadCapacity * 4 * sizeof(Vertex));
-		s_Data->vertexBuffer->SetLayout({
-			{ ShaderDataType::Float4, "a_Position" },
-			{ ShaderDataType::Float4, "a_Color" },
-
-			{ ShaderDataType::Float , "a_TexSlot" },
-			{ ShaderDataType::Float , "a_TexFilter" },
-			{ ShaderDataType::Float , "a_TexAlphaClippingThreshold" },
-			{ ShaderDataType::Float2, "a_TexWrapping" },
-			{ ShaderDataType::Float4, "a_TexBorderColor" },
-			{ ShaderDataType::Float4, "a_TexRect" },
-			{ ShaderDataType::Float2, "a_TexSize" },
-			{ ShaderDataType::Float2, "a_TexCoord" },
-			{ ShaderDataType::Float4, "a_TexCoordRange" },
-		});
-		s_Data->vertexArray->AddVertexBuffer(s_Data->vertexBuffer);
+		auto toFloat = [color](uint32_t shift) { return (float)((color >> shift) & 0xFF) / 255.0f; };
+		return Color(toFloat(0), toFloat(8), toFloat(16), toFloat(24));
+	}
 
-		s_Data->indexBuffer = IndexBuffer::Create();
-		s_Data->indexBuffer->AllocateStorage(initQuadCapacity * 6);
-		s_Data->vertexArray->SetIndexBuffer(s_Data->indexBuffer);
+	static void InsertSortEntry(QuadPass pass, const Vector4& position, uint32_t index)
+	{
+		uint64_t sequence = (uint64_t)s_Data->FlushingQuadCount & Renderer2DData::SortKeySequenceMask;
 
-		s_Data->Vertices.reserve(initQuadCapacity);
-		GenIndices(initQuadCapacity, 6 * initQuadCapacity);
-		s_Data->QuadsZIndices.reserve(initQuadCapacity);
+		const Vector4& z = s_Data->SortDepthZ;
+		const Vector4& w = s_Data->SortDepthW;
+		float depth = (z.x * position.x + z.y * position.y + z.z * position.z + z.w * position.w) /
+		              (w.x * position.x + w.y * position.y + w.z * position.z + w.w * position.w);
 
-		s_Data->BatchRenderer2DShader = Shader::Create("assets/shaders/BatchRenderer2D.glsl");
-		//s_Data->BatchRenderer2DShader = Shader::Create("BatchRenderer2D", BatchRenderer2DVertexShaderSrc, BatchRenderer2DFragmentShaderSrc);
-		s_Data->BatchRenderer2DShader->Bind();
-		s_Data->BatchRenderer2DShader->UploadUniformIntArray("u_Slots", Renderer2DData::ShaderSampler2Ds, 32);
+		uint64_t key = (uint64_t)pass << Renderer2DData::SortKeyPassShift;
+		if (pass == QuadPass_Transparent)
+		{
+			// Back to front, stable between quads with equal depth
+			key |= (uint64_t)~FloatToSortableUInt(depth) << Renderer2DData::SortKeyDepthShift | sequence;
+		}
+		else
+		{
+			// Front to back so hidden fragments fail the depth test, last submitted wins on equal depth
+			key |= (uint64_t)FloatToSortableUInt(depth) << Renderer2DData::SortKeyDepthShift | (Renderer2DData::SortKeySequenceMask - sequence);
+		}
 
-		s_Statistics.Reset();
+		s_Data->SortEntries.push_back({ key, index });
 	}
 
-	void Renderer2D::Shutdown()
+	/////////////////////////////////////////////////////////
+	// Quad Expansion ///////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	// Builds translate(position) * rotate(rotation, Z) * scale(size) without the three temporary matrices
+	static Mat4x4 MakeQuadTransform(const Vector3& position, float rotation, const Vector2& size)
 	{
-		delete s_Data;
+		float c = std::cos(rotation);
+		float s = std::sin(rotation);
+
+		Mat4x4 transform(1.0f);
+		transform[0] = Vector4( c * size.x, s * size.x, 0.0f, 0.0f);
+		transform[1] = Vector4(-s * size.y, c * size.y, 0.0f, 0.0f);
+		transform[3] = Vector4(position, 1.0f);
+		return transform;
 	}
 
-	Ref<Shader>& Renderer2D::GetShader()
+	/**
+	 * Writes the world space position of the 4 corners of a unit quad.
+	 * The quad lies on the local XY plane so only columns 0, 1 and 3 of transform are needed:
+	 *   corner = W +- X / 2 +- Y / 2
+	 * The SSE path stores 4 floats per corner, the 4th lands on a_Color which is written afterwards.
+	 */
+	static void ExpandQuadCorners(const Mat4x4& transform, DrawQuadVertices& vertices)
 	{
-		return s_Data->BatchRenderer2DShader;
+	#if OE_RENDERER2D_SSE
+		__m128 half = _mm_set1_ps(0.5f);
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(&transform[0][0]), half);
+		__m128 y = _mm_mul_ps(_mm_loadu_ps(&transform[1][0]), half);
+		__m128 w = _mm_loadu_ps(&transform[3][0]);
+
+		__m128 bottom = _mm_sub_ps(w, y);
+		__m128 top = _mm_add_ps(w, y);
+
+		_mm_storeu_ps(&vertices[0].a_Position.x, _mm_sub_ps(bottom, x));
+		_mm_storeu_ps(&vertices[1].a_Position.x, _mm_add_ps(bottom, x));
+		_mm_storeu_ps(&vertices[2].a_Position.x, _mm_add_ps(top, x));
+		_mm_storeu_ps(&vertices[3].a_Position.x, _mm_sub_ps(top, x));
+	#else
+		Vector4 x = 0.5f * transform[0];
+		Vector4 y = 0.5f * transform[1];
+		Vector4 w = transform[3];
+
+		vertices[0].a_Position = Vector3(w - x - y);
+		vertices[1].a_Position = Vector3(w + x - y);
+		vertices[2].a_Position = Vector3(w + x + y);
+		vertices[3].a_Position = Vector3(w - x + y);
+	#endif
 	}
 
-	void Renderer2D::Reset()
+	static QuadPass GetTexturedQuadPass(const TextureDescriptorEntry& entry, const Color& tint, float alphaClippingThreshold)
 	{
-		s_Data->Vertices.clear();
-		s_Data->QuadsZIndices.clear();
-		s_Data->OpaqueInsertIndex = 0;
-		s_Data->FlushingQuadCount = 0;
-		s_Data->TextureBindList.clear();
+		if (tint.a < 1.0f)
+			return QuadPass_Transparent;
 
-		s_Statistics.Reset();
-	}
+		if (!entry.HasAlpha)
+			return QuadPass_Opaque;
 
-	void Renderer2D::BeginScene(const Mat4x4& viewProjectionMatrix)
-	{
-		Reset();
-		s_Data->ViewProjectionMatrix = viewProjectionMatrix;
+		// Cutouts are drawn as binary alpha, so they can write depth like opaque quads
+		if (s_Data->EarlyDepth && alphaClippingThreshold > 0.0f)
+			return QuadPass_AlphaClip;
+
+		return QuadPass_Transparent;
 	}
 
-	void Renderer2D::BeginScene(const Mat4x4& viewMatrix, const Camera& camera)
+	/**
+	 * texDescriptor : TextureDescriptor index or -1 for untextured quads
+	 * textureID : Renderer ID of the GPU texture to sample from, slots are assigned on Flush
+	 */
+	static void InsertQuad(QuadPass pass, const Mat4x4& transform, const Color& tint, int texDescriptor, uint32_t textureID)
 	{
-		Reset();
-		s_Data->ViewProjectionMatrix = camera.GetProjection() * viewMatrix;
+		s_Data->QuadTextureIDs.push_back(textureID);
+
+		if (s_Data->InstancedRendering)
+		{
+			InstanceVertex instance;
+
+			instance.a_TransformX = Vector3(transform[0]);
+			instance.a_TransformY = Vector3(transform[1]);
+			instance.a_TransformW = Vector3(transform[3]);
+			instance.a_Color = PackColor(tint);
+			instance.a_TexDescriptor = texDescriptor == -1 ? 0 : (uint32_t)texDescriptor;
+
+			InsertSortEntry(pass, transform[3], (uint32_t)s_Data->Instances.size());
+			s_Data->Instances.push_back(instance);
+			return;
+		}
+
+		DrawQuadVertices vertices;
+		ExpandQuadCorners(transform, vertices);
+
+		uint32_t color = PackColor(tint);
+
+		for (int i = 0; i < 4; i++)
+		{
+			Vertex& vertex = vertices[i];
+			vertex.a_Color = color;
+
+			if (texDescriptor != -1)
+			{
+				float cornerX = Renderer2DData::QuadVertices[    3 * i];
+				float cornerY = Renderer2DData::QuadVertices[1 + 3 * i];
+
+				vertex.a_TexDescriptor = (uint32_t)texDescriptor;
+				vertex.a_TexCorner = { (uint16_t)(cornerX > 0.0f ? 0xFFFF : 0), (uint16_t)(cornerY > 0.0f ? 0xFFFF : 0) };
+			}
+		}
+
+		InsertSortEntry(pass, transform[3], (uint32_t)s_Data->Vertices.size());
+		s_Data->Vertices.push_back(vertices);
 	}
 
-	void Renderer2D::BeginScene(const Mat4x4& viewMatrix, const Mat4x4& projectionMatrix)
+	static bool IsSameSamplingOverride(const TexturedQuadExtraData& a, const TexturedQuadExtraData& b)
 	{
-		Reset();
-		s_Data->ViewProjectionMatrix = projectionMatrix * viewMatrix;
+		return a.Tiling == b.Tiling && a.Offset == b.Offset &&
+			a.Flip.x == b.Flip.x && a.Flip.y == b.Flip.y &&
+			a.Wrapping.x == b.Wrapping.x && a.Wrapping.y == b.Wrapping.y &&
+			a.Filtering == b.Filtering &&
+			a.AlphaClipThreshold == b.AlphaClipThreshold &&
+			a.TextureBorderColor.first == b.TextureBorderColor.first &&
+			(!a.TextureBorderColor.first || a.TextureBorderColor.second == b.TextureBorderColor.second);
 	}
 
-	void Renderer2D::EndScene()
+	/**
+	 * Whether the shader can let the sampler filter the atlas directly, true when
+	 * the sampled area never leaves the texture's rect so Repeat / Mirror / Border
+	 * don't need emulating. Linear filtering also needs the gutter around masters.
+	 */
+	static bool CanUseHardwareSampling(const Ref<Texture2D>& texture, TextureFiltering filtering, TextureWrapping xWrapping, TextureWrapping yWrapping, const Rect& texCoordRange)
 	{
-		Flush();
+		auto clamps = [](TextureWrapping wrapping) { return wrapping == TextureWrapping::None || wrapping == TextureWrapping::ClampToEdge; };
+		auto insideRect = [](float a, float b) { return std::min(a, b) >= 0.0f && std::max(a, b) <= 1.0f; };
+
+		if (!clamps(xWrapping) && !insideRect(texCoordRange.x, texCoordRange.z))
+			return false;
+
+		if (!clamps(yWrapping) && !insideRect(texCoordRange.y, texCoordRange.w))
+			return false;
+
+		if (filtering == TextureFiltering::Nearest)
+			return true;
+
+		return texture->GetType() == TextureType::Master && TextureManager::GetAtlasGutter(texture->GetGPUTexture()) > 0;
 	}
 
-	void Renderer2D::Flush()
+	static void WriteTextureDescriptor(uint32_t index, const Ref<Texture2D>& texture)
 	{
-		if (s_Data->FlushingQuadCount == 0) // Nothing to draw
-			return;
+		TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries[index];
+		TextureDescriptor& descriptor = s_Data->TextureDescriptors[index];
+		const TexturedQuadExtraData& extraData = entry.Overrides;
 
-		uint32_t indexCount = s_Statistics.GetIndexCount();
+		entry.Revision = texture->GetRevision();
+		entry.GPUTexture = texture->GetGPUTexture();
+		entry.GPUTextureID = entry.GPUTexture->GetRendererID();
 
-		// Grow GPU Buffers
-		if (s_Data->QuadCapacity < s_Data->FlushingQuadCount)
+		TextureFiltering filtering = extraData.Filtering != TextureFiltering::None ? extraData.Filtering : texture->GetFiltering();
+		TextureWrapping xWrapping = extraData.Wrapping.x != TextureWrapping::None ? extraData.Wrapping.x : texture->GetXWrapping();
+		TextureWrapping yWrapping = extraData.Wrapping.y != TextureWrapping::None ? extraData.Wrapping.y : texture->GetYWrapping();
+
+		descriptor.TexParams = (uint32_t)filtering | (uint32_t)xWrapping << 4 | (uint32_t)yWrapping << 8;
+		descriptor.TexAlphaClippingThreshold = extraData.AlphaClipThreshold;
+
+		if (extraData.TextureBorderColor.first)
+			descriptor.TexBorderColor = extraData.TextureBorderColor.second;
+		else
+			descriptor.TexBorderColor = texture->GetBorderColor();
+
+		// A translucent border shows through around RGB textures too
+		bool clampsToBorder = xWrapping == TextureWrapping::ClampToBorder || yWrapping == TextureWrapping::ClampToBorder;
+		entry.HasAlpha = texture->GetFormat() == TextureFormat::RGBA || (clampsToBorder && descriptor.TexBorderColor.a < 1.0f);
+
+		descriptor.TexRect = texture->GetRect();
+		descriptor.TexSize = { texture->GetWidth(), texture->GetHeight() };
+
+		// TexCoord of min & max corners
 		{
-			s_Data->QuadCapacity = s_Data->FlushingQuadCount;
-			s_Data->vertexBuffer->AllocateStorage(s_Data->QuadCapacity * 4 * sizeof(Vertex));
-			GenIndices(s_Data->QuadCapacity, indexCount);
+			float minXTexCoord = extraData.Offset.x;
+			float minYTexCoord = extraData.Offset.y;
+			float maxXTexCoord = extraData.Tiling.x + extraData.Offset.x;
+			float maxYTexCoord = extraData.Tiling.y + extraData.Offset.y;
+
+			descriptor.TexCoordRange.x = extraData.Flip.x ? extraData.Tiling.x - minXTexCoord : minXTexCoord; // Min X
+			descriptor.TexCoordRange.y = extraData.Flip.y ? extraData.Tiling.y - minYTexCoord : minYTexCoord; // Min Y
+			descriptor.TexCoordRange.z = extraData.Flip.x ? extraData.Tiling.x - maxXTexCoord : maxXTexCoord; // Max X
+			descriptor.TexCoordRange.w = extraData.Flip.y ? extraData.Tiling.y - maxYTexCoord : maxYTexCoord; // Max Y
 		}
 
-		// Upload Data
-		s_Data->vertexBuffer->BufferSubData((float*)s_Data->Vertices.data(), s_Statistics.GetVertexCount() * sizeof(Vertex));
-
-		// Bind Textures
-		for (auto& t : s_Data->TextureBindList)
-			t.second->Bind(t.first);
+		if (CanUseHardwareSampling(texture, filtering, xWrapping, yWrapping, descriptor.TexCoordRange))
+		{
+			descriptor.TexParams |= 1 << 12;
+			entry.ShaderFlags = filtering == TextureFiltering::Nearest ? BatchShader_PointClamp : BatchShader_LinearClamp;
+		}
+		else
+		{
+			entry.ShaderFlags = BatchShader_Emulated;
+		}
 
-		// Bind VertexArray
-		s_Data->vertexArray->Bind();
+		// Quads under the threshold are dropped on submit, only texture or border alpha can reach it
+		if (entry.HasAlpha || clampsToBorder)
+			entry.ShaderFlags |= BatchShader_AlphaClip;
 
-		// Bind Shader
-		s_Data->BatchRenderer2DShader->Bind();
+		int layer = entry.GPUTexture->GetArrayLayer();
+		if (layer != -1)
+			descriptor.TexParams |= (uint32_t)layer << 16;
 
-		// DrawCall
-		RenderCommand::DrawIndexed(s_Data->vertexArray, indexCount);
-		s_Statistics.DrawCalls++;
+		if (s_Data->TextureDescriptorsDirtyBegin == s_Data->TextureDescriptorsDirtyEnd)
+		{
+			s_Data->TextureDescriptorsDirtyBegin = index;
+			s_Data->TextureDescriptorsDirtyEnd = index + 1;
+		}
+		else
+		{
+			s_Data->TextureDescriptorsDirtyBegin = std::min(s_Data->TextureDescriptorsDirtyBegin, (uint32_t)index);
+			s_Data->TextureDescriptorsDirtyEnd = std::max(s_Data->TextureDescriptorsDirtyEnd, (uint32_t)index + 1);
+		}
 	}
 
-	void Renderer2D::FlushAndReset()
+	static void ClearTextureDescriptors()
 	{
-		Flush();
-
-		s_Data->Vertices.clear();
-		s_Data->QuadsZIndices.clear();
-		s_Data->OpaqueInsertIndex = 0;
-		s_Data->FlushingQuadCount = 0;
-		s_Data->TextureBindList.clear();
+		s_Data->TextureDescriptors.clear();
+		s_Data->TextureDescriptorEntries.clear();
+		s_Data->TextureDescriptorLookup.clear();
+		s_Data->TextureDescriptorsDirtyBegin = 0;
+		s_Data->TextureDescriptorsDirtyEnd = 0;
+		s_Data->TextureDescriptorEpoch++;
+		s_Data->TextureDescriptorsCleared = true;
 	}
 
-	/////////////////////////////////////////////////////////
-	// FlatColor Quad ///////////////////////////////////////
-	/////////////////////////////////////////////////////////
-
-	void Renderer2D::DrawQuad(const Vector2& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold)
+	/**
+	 * Descriptors of dead textures and of overrides not drawn anymore (a scrolling Offset adds one each
+	 * frame) are never looked up again. Called between geometries, when nothing references the table but
+	 * the retained batches, which acquire their descriptors again; so only once the table grew well past
+	 * what one geometry actually uses.
+	 */
+	static void RecycleTextureDescriptors()
 	{
-		DrawQuad(Vector3(position, 0.0f), rotation, size, color, alphaClippingThreshold);
+		uint32_t size = (uint32_t)s_Data->TextureDescriptors.size();
+
+		if (s_Data->TextureDescriptorsCleared)
+		{
+			s_Data->TextureDescriptorBaseline = size;
+			s_Data->TextureDescriptorsCleared = false;
+		}
+		else if (size > 2 * s_Data->TextureDescriptorBaseline + Renderer2DData::MinRecycledDescriptors)
+		{
+			ClearTextureDescriptors();
+		}
 	}
 
-	void Renderer2D::DrawQuad(const Vector3& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold)
+	// Counted only when there is something to flush
+	static void CountFlush(Renderer2D::FlushReason reason)
 	{
-		Mat4x4 transform =
-			glm::translate(Mat4x4(1.0f), position) *
-			glm::rotate(Mat4x4(1.0f), rotation, Vector3(0, 0, 1)) *
-			glm::scale(Mat4x4(1.0f), Vector3(size, 1.0f));
-
-		DrawQuad(transform, color, alphaClippingThreshold);
+		if (s_Data->FlushingQuadCount != 0 || !s_Data->RetainedBatches.empty())
+			Renderer2D::GetStatistics().Flushes[reason]++;
 	}
 
-	void Renderer2D::DrawQuad(const Mat4x4& transform, const Color& color, float alphaClippingThreshold)
+	/**
+	 * Returns the descriptor of (texture, extraData), creating or refreshing it when needed.
+	 * InvalidTextureDescriptor if the table is full while recording geometry, which can't be flushed without a camera.
+	 */
+	static uint32_t AcquireTextureDescriptor(const Ref<Texture2D>& texture, const TexturedQuadExtraData& extraData)
 	{
-		if (color.a <= alphaClippingThreshold)
-			return;
+		// Maps evicted textures back, bumping the revision checked below
+		TextureManager::MarkUsed(*texture);
 
-		bool transparent = color.a < 1.0f;
+		auto& candidates = s_Data->TextureDescriptorLookup[texture.get()];
 
-		DrawQuadVertices vertices;
+		// Address was reused by a new texture
+		if (!candidates.empty() && s_Data->TextureDescriptorEntries[candidates[0]].Texture.expired())
+			candidates.clear();
 
-		for (int i = 0; i < 4; i++)
+		for (uint32_t index : candidates)
 		{
-			Vertex& vertex = vertices[i];
+			const TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries[index];
+			if (!IsSameSamplingOverride(entry.Overrides, extraData))
+				continue;
 
-			vertex.a_Position.x = Renderer2DData::QuadVertices[3 * i];
-			vertex.a_Position.y = Renderer2DData::QuadVertices[1 + 3 * i];
-			vertex.a_Position.z = Renderer2DData::QuadVertices[2 + 3 * i];
-			vertex.a_Position.w = 1.0f;
-			vertex.a_Position = s_Data->ViewProjectionMatrix * transform * vertex.a_Position;
+			if (entry.Revision != texture->GetRevision())
+				WriteTextureDescriptor(index, texture);
 
-			vertex.a_Color = color;
+			return index;
 		}
 
-		InsertVertices(transparent, transform[3].z, vertices);
+		// Keeps the lookup cheap for textures drawn with ever changing overrides
+		if (candidates.size() == Renderer2DData::MaxDescriptorsPerTexture)
+			candidates.erase(candidates.begin());
 
-		s_Statistics.QuadCount++;
-		s_Data->FlushingQuadCount++;
-	}
+		if (s_Data->TextureDescriptors.size() == Renderer2DData::MaxTextureDescriptors)
+		{
+			if (!s_Data->HasCamera)
+			{
+				OE_CORE_ERROR("Texture descriptor table is full, quad is dropped from the geometry!");
+				return Renderer2DData::InvalidTextureDescriptor;
+			}
 
-	/////////////////////////////////////////////////////////
-	// Textured Quad ////////////////////////////////////////
-	/////////////////////////////////////////////////////////
+			// Pending quads reference the old table
+			CountFlush(Renderer2D::FlushReason_DescriptorOverflow);
+			Renderer2D::FlushAndReset();
+			ClearTextureDescriptors();
+			return AcquireTextureDescriptor(texture, extraData);
+		}
 
-	void Renderer2D::DrawQuad(const Vector2& position, float rotation, const Vector2& size, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
-	{
-		DrawQuad(Vector3(position, 0.0f), rotation, size, texture, extraData);
+		uint32_t index = (uint32_t)s_Data->TextureDescriptors.size();
+		s_Data->TextureDescriptors.emplace_back();
+
+		TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries.emplace_back();
+		entry.Texture = texture;
+		entry.Overrides = extraData;
+
+		candidates.push_back(index);
+		WriteTextureDescriptor(index, texture);
+		return index;
 	}
 
-	void Renderer2D::DrawQuad(const Vector3& position, float rotation, const Vector2& size, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	// Keeps the GPU texture alive and addressable by its renderer ID until the pending quads are flushed
+	static uint32_t RegisterPendingTexture(const TextureDescriptorEntry& entry)
 	{
-		Mat4x4 transform =
-			glm::translate(Mat4x4(1.0f), position) *
-			glm::rotate(Mat4x4(1.0f), rotation, Vector3(0, 0, 1)) *
-			glm::scale(Mat4x4(1.0f), Vector3(size, 1.0f));
+		uint32_t id = entry.GPUTextureID;
+		if (id >= s_Data->TextureBindStates.size())
+			s_Data->TextureBindStates.resize(id + 1);
 
-		DrawQuad(transform, texture, extraData);
+		TextureBindState& state = s_Data->TextureBindStates[id];
+		if (state.PendingStamp != s_Data->PendingStamp)
+		{
+			state.PendingStamp = s_Data->PendingStamp;
+			state.Texture = entry.GPUTexture.get();
+			state.Paged = entry.GPUTexture->GetArrayLayer() != -1;
+			s_Data->PendingTextures.push_back(entry.GPUTexture);
+		}
+
+		return id;
 	}
 
-	void Renderer2D::DrawQuad(const Mat4x4& transform, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	static void UploadTextureDescriptors()
 	{
-		if (!texture || texture->GetType() == TextureType::Placeholder)
-			return;
+		uint32_t begin = s_Data->TextureDescriptorsDirtyBegin;
+		uint32_t end = s_Data->TextureDescriptorsDirtyEnd;
 
-		Ref<GAPI::Texture2D> textureToBind = texture->GetGPUTexture();
+		if (begin == end)
+			return;
 
-		int textureSlot = -1;
-		for (const auto& t : s_Data->TextureBindList)
+		uint32_t requiredSize = (uint32_t)s_Data->TextureDescriptors.size() * sizeof(TextureDescriptor);
+		if (s_Data->textureDescriptorBuffer->GetSize() < requiredSize)
 		{
-			if (*t.second == *textureToBind)
-			{
-				textureSlot = t.first;
-				break;
-			}
-		}
+			uint32_t maxSize = Renderer2DData::MaxTextureDescriptors * sizeof(TextureDescriptor);
+			s_Data->textureDescriptorBuffer->AllocateStorage(std::min(std::max(requiredSize, 2 * s_Data->textureDescriptorBuffer->GetSize()), maxSize));
 
-		if (textureSlot == -1)
-		{
-			uint32_t slot = (uint32_t)s_Data->TextureBindList.size();
-			if (slot + 1 > RenderCommand::GetMaxTextureSlotCount())
-			{
-				Flush();
-				Reset();
-				slot = 0;
-			}
-			s_Data->TextureBindList[slot] = textureToBind;
-			textureSlot = slot;
+			// Reallocation drops the old contents
+			begin = 0;
+			end = (uint32_t)s_Data->TextureDescriptors.size();
 		}
 
-		if (extraData.AlphaClipThreshold >= 1.0f || extraData.Tint.a <= extraData.AlphaClipThreshold)
+		s_Data->textureDescriptorBuffer->BufferSubData(
+			s_Data->TextureDescriptors.data() + begin,
+			(end - begin) * sizeof(TextureDescriptor),
+			begin * sizeof(TextureDescriptor)
+		);
+		Renderer2D::GetStatistics().UploadedBytes += (end - begin) * sizeof(TextureDescriptor);
+
+		s_Data->TextureDescriptorsDirtyBegin = 0;
+		s_Data->TextureDescriptorsDirtyEnd = 0;
+	}
+
+	// LSD radix sort (8 bits per pass), passes which all keys agree on are skipped
+	static void RadixSortEntries(Vector<QuadSortEntry>& entries, Vector<QuadSortEntry>& scratch)
+	{
+		size_t count = entries.size();
+		if (count < 2)
 			return;
 
-		bool transparent = extraData.Tint.a < 1.0f || texture->GetFormat() == TextureFormat::RGBA;
+		scratch.resize(count);
 
-		DrawQuadVertices vertices;
+		std::array<std::array<uint32_t, 256>, 8> histograms{};
+		for (const auto& entry : entries)
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
 
-		for (int i = 0; i < 4; i++)
+		QuadSortEntry* src = entries.data();
+		QuadSortEntry* dst = scratch.data();
+
+		for (uint32_t pass = 0; pass < 8; pass++)
 		{
-			Vertex& vertex = vertices[i];
+			auto& histogram = histograms[pass];
+			uint32_t shift = pass * 8;
 
-			vertex.a_Position.x = Renderer2DData::QuadVertices[    3 * i];
-			vertex.a_Position.y = Renderer2DData::QuadVertices[1 + 3 * i];
-			vertex.a_Position.z = Renderer2DData::QuadVertices[2 + 3 * i];
-			vertex.a_Position.w = 1.0f;
-			vertex.a_Position = s_Data->ViewProjectionMatrix * transform * vertex.a_Position;
+			if (histogram[(src[0].Key >> shift) & 0xFF] == count)
+				continue;
 
-			vertex.a_Color = extraData.Tint;
+			uint32_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				uint32_t bucketSize = bucket;
+				bucket = offset;
+				offset += bucketSize;
+			}
 
-			// a_TexSlot
-			vertex.a_TexSlot = (float)textureSlot;
+			for (size_t i = 0; i < count; i++)
+				dst[histogram[(src[i].Key >> shift) & 0xFF]++] = src[i];
 
-			// a_TexFilter
-			if (extraData.Filtering != TextureFiltering::None)
-				vertex.a_TexFilter = (float)extraData.Filtering;
-			else
-				vertex.a_TexFilter = (float)texture->GetFiltering();
+			std::swap(src, dst);
+		}
 
-			vertex.a_TexAlphaClippingThreshold = extraData.AlphaClipThreshold;
+		if (src != entries.data())
+			entries.swap(scratch);
+	}
 
-			// a_TexSWrapping & a_TexTWrapping
-			if (extraData.Wrapping.x != TextureWrapping::None)
-				vertex.a_TexWrapping.x = (float)extraData.Wrapping.x;
-			else
-				vertex.a_TexWrapping.x = (float)texture->GetXWrapping();
+	static void GenIndices(uint32_t quadCount, uint32_t indexCount)
+	{
+		// Allocate storage on GPU memory
+		s_Data->indexBuffer->AllocateStorage(indexCount);
 
-			if (extraData.Wrapping.y != TextureWrapping::None)
-				vertex.a_TexWrapping.y = (float)extraData.Wrapping.y;
-			else
-				vertex.a_TexWrapping.y = (float)texture->GetYWrapping();
+		s_Data->Indices.reserve(quadCount);
+		for (uint32_t i = (uint32_t)s_Data->Indices.size(); i < quadCount; i++)
+		{
+			// Generate indices
+			DrawQuadIndices indices;
+			for (uint32_t j = 0; j < 6; j++)
+				indices[j] = Renderer2DData::QuadIndices[j] + 4 * i;
+			s_Data->Indices.push_back(indices);
+		}
 
-			// a_TexBorderColor
-			if (extraData.TextureBorderColor.first)
-				vertex.a_TexBorderColor = extraData.TextureBorderColor.second;
-			else
-				vertex.a_TexBorderColor = texture->GetBorderColor();
+		// Upload data to GPU
+		s_Data->indexBuffer->BufferSubData((uint32_t*)s_Data->Indices.data(), indexCount);
+		Renderer2D::GetStatistics().UploadedBytes += indexCount * sizeof(uint32_t);
+	}
+
+	// (Re)creates the vertex stream with room for quadCapacity quads per region
+	static void CreateVertexStream(uint32_t quadCapacity)
+	{
+		s_Data->QuadCapacity = quadCapacity;
+
+		s_Data->vertexStream = StreamingBuffer::Create(quadCapacity * sizeof(DrawQuadVertices), Renderer2DData::StreamRegionCount);
+		s_Data->vertexStream->SetLayout({
+			{ ShaderDataType::Float3 , "a_Position" },
+			{ ShaderDataType::UByte4 , "a_Color", true },
+			{ ShaderDataType::Int    , "a_TexDescriptor" },
+			{ ShaderDataType::UShort2, "a_TexCorner", true },
+		});
 
-			// a_TexRect
-			vertex.a_TexRect = texture->GetRect();
+		s_Data->vertexArray = VertexArray::Create();
+		s_Data->vertexArray->AddVertexBuffer(s_Data->vertexStream);
+		s_Data->vertexArray->SetIndexBuffer(s_Data->indexBuffer);
 
-			// a_TexSize
-			vertex.a_TexSize = { texture->GetWidth() ,texture->GetHeight() };
+		GenIndices(quadCapacity, 6 * quadCapacity);
+	}
 
-			// a_TexCoord
-			{
-				float xTexCoord = Renderer2DData::QuadVertices[    3 * i] > 0.0f ? extraData.Tiling.x + extraData.Offset.x : extraData.Offset.x;
-				float yTexCoord = Renderer2DData::QuadVertices[1 + 3 * i] > 0.0f ? extraData.Tiling.y + extraData.Offset.y : extraData.Offset.y;
-				vertex.a_TexCoord.x = extraData.Flip.x ? extraData.Tiling.x - xTexCoord : xTexCoord;
-				vertex.a_TexCoord.y = extraData.Flip.y ? extraData.Tiling.y - yTexCoord : yTexCoord;
+	static BufferLayout InstanceVertexLayout()
+	{
+		return {
+			{ ShaderDataType::Float3, "a_TransformX" },
+			{ ShaderDataType::Float3, "a_TransformY" },
+			{ ShaderDataType::Float3, "a_TransformW" },
+			{ ShaderDataType::UByte4, "a_Color", true },
+			{ ShaderDataType::Int   , "a_TexDescriptor" },
+		};
+	}
 
-				vertex.a_TexCoordRange.x = extraData.Flip.x ? extraData.Tiling.x - extraData.Offset.x : extraData.Offset.x; // Min X
-				vertex.a_TexCoordRange.y = extraData.Flip.y ? extraData.Tiling.y - extraData.Offset.y : extraData.Offset.y; // Min Y
+	// (Re)creates the instance stream with room for instanceCapacity instances per region
+	static void CreateInstanceStream(uint32_t instanceCapacity)
+	{
+		s_Data->InstanceCapacity = instanceCapacity;
 
-				float maxXTexCoord = extraData.Tiling.x + extraData.Offset.x;
-				float maxYTexCoord = extraData.Tiling.y + extraData.Offset.y;
+		s_Data->instanceStream = StreamingBuffer::Create(instanceCapacity * sizeof(InstanceVertex), Renderer2DData::StreamRegionCount);
+		s_Data->instanceStream->SetLayout(InstanceVertexLayout());
 
-				vertex.a_TexCoordRange.z = extraData.Flip.x ? extraData.Tiling.x - maxXTexCoord : maxXTexCoord; // Max X
-				vertex.a_TexCoordRange.w = extraData.Flip.y ? extraData.Tiling.y - maxYTexCoord : maxYTexCoord; // Max Y
-			}
-		}
+		// Instanced path; one record per quad and no index buffer
+		s_Data->instanceVertexArray = VertexArray::Create();
+		s_Data->instanceVertexArray->AddVertexBuffer(s_Data->instanceStream, 1);
+	}
 
-		InsertVertices(transparent, transform[3].z, vertices);
+	/**
+	 * Returns the batch shader permutation for flags, compiling it on first use.
+	 * A batch mixing sampling paths falls back to picking them per fragment.
+	 */
+	static Ref<Shader>& GetBatchShader(uint32_t flags)
+	{
+		uint32_t sampling = flags & BatchShader_SamplingMask;
+		if (sampling & (sampling - 1))
+			flags = (flags & ~BatchShader_SamplingMask) | BatchShader_Emulated;
+
+		Ref<Shader>& shader = s_Data->BatchShaders[flags];
+		if (shader)
+			return shader;
+
+		Vector<String> defines;
+		sampling = flags & BatchShader_SamplingMask;
+		if (sampling == 0)
+			defines.push_back("UNTEXTURED");
+		else if (sampling == BatchShader_PointClamp)
+			defines.push_back("POINT_CLAMP");
+		else if (sampling == BatchShader_LinearClamp)
+			defines.push_back("LINEAR_CLAMP");
+
+		if (flags & BatchShader_AlphaClip)
+			defines.push_back("ALPHA_CLIP");
+		if (flags & BatchShader_Paged)
+			defines.push_back("OE_TEXTURE_PAGES");
+
+		const char* filePath = (flags & BatchShader_Instanced) ? "assets/shaders/BatchRenderer2DInstanced.glsl" : "assets/shaders/BatchRenderer2D.glsl";
+		shader = s_Data->BatchShaderPermutations.LoadPermutation(filePath, defines);
+
+		if (flags & BatchShader_Paged)
+			shader->UploadUniformInt("u_Pages", 0);
+		else
+			shader->UploadUniformIntArray("u_Slots", Renderer2DData::ShaderSampler2Ds, 32);
+		shader->UploadUniformInt("u_Overdraw", s_Data->OverdrawDebug);
+
+		return shader;
+	}
 
-		s_Statistics.QuadCount++;
-		s_Data->FlushingQuadCount++;
+	void Renderer2D::Init(uint32_t initQuadCapacity)
+	{
+		s_Data = new Renderer2DData();
+
+		s_Data->indexBuffer = IndexBuffer::Create();
+		CreateVertexStream(initQuadCapacity);
+		CreateInstanceStream(initQuadCapacity);
+
+		s_Data->Vertices.reserve(initQuadCapacity);
+		s_Data->Instances.reserve(initQuadCapacity);
+		s_Data->SortEntries.reserve(initQuadCapacity);
+		s_Data->SortScratch.reserve(initQuadCapacity);
+
+		s_Data->textureDescriptorBuffer = ShaderStorageBuffer::Create();
+		s_Data->cameraBuffer = UniformBuffer::Create(sizeof(CameraData));
+
+		// Other permutations are compiled by the first batch using them
+		GetBatchShader(BatchShader_Generic);
+		GetBatchShader(BatchShader_Generic | BatchShader_Instanced);
+
+		s_Statistics.Reset();
+	}
+
+	void Renderer2D::Shutdown()
+	{
+		Renderer2DCapture::EndRecording();
+		delete s_Data;
+	}
+
+	Ref<Shader>& Renderer2D::GetShader()
+	{
+		if (s_Data->InstancedRendering)
+			return GetBatchShader(BatchShader_Generic | BatchShader_Instanced);
+		return GetBatchShader(BatchShader_Generic);
+	}
+
+	void Renderer2D::SetInstancedRendering(bool enabled)
+	{
+		if (s_Data->InstancedRendering == enabled)
+			return;
+
+		// Pending quads are stored in the format of the previous mode
+		CountFlush(FlushReason_ModeSwitch);
+		FlushAndReset();
+		s_Data->InstancedRendering = enabled;
+	}
+
+	bool Renderer2D::IsInstancedRendering()
+	{
+		return s_Data->InstancedRendering;
+	}
+
+	void Renderer2D::SetEarlyDepth(bool enabled)
+	{
+		s_Data->EarlyDepth = enabled;
+	}
+
+	bool Renderer2D::IsEarlyDepth()
+	{
+		return s_Data->EarlyDepth;
+	}
+
+	void Renderer2D::SetOverdrawDebug(bool enabled)
+	{
+		s_Data->OverdrawDebug = enabled;
+
+		for (auto& shader : s_Data->BatchShaders)
+		{
+			if (shader)
+				shader->UploadUniformInt("u_Overdraw", enabled);
+		}
+	}
+
+	bool Renderer2D::IsOverdrawDebug()
+	{
+		return s_Data->OverdrawDebug;
+	}
+
+	void Renderer2D::Reset()
+	{
+		s_Data->Vertices.clear();
+		s_Data->Instances.clear();
+		s_Data->SortEntries.clear();
+		s_Data->QuadTextureIDs.clear();
+		s_Data->FlushingQuadCount = 0;
+
+		s_Data->PendingTextures.clear();
+		s_Data->PendingStamp++;
+
+		s_Data->Batches.clear();
+		s_Data->BatchTextures.clear();
+		s_Data->RetainedBatches.clear();
+	}
+
+	void Renderer2D::BeginFrame()
+	{
+		s_Statistics.Reset();
+
+		RenderCommand::NextGPUTimerFrame();
+		s_Statistics.GPUMilliseconds = (double)RenderCommand::GetGPUFrameTime() / 1e6;
+		for (uint32_t view = 0; view < RendererAPI::MaxGPUTimerViews; view++)
+			s_Statistics.ViewGPUMilliseconds[view] = (double)RenderCommand::GetGPUViewTime(view) / 1e6;
+	}
+
+	static void ResetGeometry()
+	{
+		Renderer2D::Reset();
+		RecycleTextureDescriptors();
+		s_Data->HasCamera = false;
+
+		// A view starts with each scene, statistics add up over the frame
+		s_Data->View = Renderer2D::GetStatistics().ViewCount++;
+		s_Data->SubmitStart = Time::GetTimeDouble();
+
+		s_Data->SortDepthZ = Vector4(0.0f, 0.0f, -1.0f, 0.0f);
+		s_Data->SortDepthW = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	void Renderer2D::BeginScene(const Mat4x4& viewProjectionMatrix)
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordBeginScene(viewProjectionMatrix);
+
+		ResetGeometry();
+		s_Data->ViewProjectionMatrix = viewProjectionMatrix;
+		s_Data->HasCamera = true;
+
+		// Camera is known, sort by its view depth
+		const Mat4x4& m = viewProjectionMatrix;
+		s_Data->SortDepthZ = Vector4(m[0][2], m[1][2], m[2][2], m[3][2]);
+		s_Data->SortDepthW = Vector4(m[0][3], m[1][3], m[2][3], m[3][3]);
+	}
+
+	void Renderer2D::BeginScene(const Mat4x4& viewMatrix, const Camera& camera)
+	{
+		BeginScene(camera.GetProjection() * viewMatrix);
+	}
+
+	void Renderer2D::BeginScene(const Mat4x4& viewMatrix, const Mat4x4& projectionMatrix)
+	{
+		BeginScene(projectionMatrix * viewMatrix);
+	}
+
+	void Renderer2D::EndScene()
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordEndScene();
+
+		CountFlush(FlushReason_EndScene);
+		Flush();
+	}
+
+	static void SetTextureSlot(DrawQuadVertices& quad, uint32_t slotBits)
+	{
+		for (auto& vertex : quad)
+			vertex.a_TexDescriptor |= slotBits;
+	}
+
+	static void SetTextureSlot(InstanceVertex& quad, uint32_t slotBits)
+	{
+		quad.a_TexDescriptor |= slotBits;
+	}
+
+	static uint32_t GetTextureDescriptor(const DrawQuadVertices& quad)
+	{
+		return quad[0].a_TexDescriptor & (Renderer2DData::MaxTextureDescriptors - 1);
+	}
+
+	static uint32_t GetTextureDescriptor(const InstanceVertex& quad)
+	{
+		return quad.a_TexDescriptor & (Renderer2DData::MaxTextureDescriptors - 1);
+	}
+
+	/**
+	 * Copies the sorted quads to destination and splits them into batches.
+	 * A batch is the longest run of quads (in sort order) which references at most maxSlots
+	 * distinct GPU textures, which gives the minimum number of draw calls for that order.
+	 * Texture slots are assigned per batch and patched into the quads while copying.
+	 * Textures living in TextureManager's pages share one binding and never split a batch,
+	 * unless the run switches between paged and slot bound textures.
+	 */
+	template<typename QuadType>
+	static void BuildBatches(QuadType* destination, const Vector<QuadType>& quads)
+	{
+		uint32_t quadCount = s_Data->FlushingQuadCount;
+		uint32_t maxSlots = std::min(RenderCommand::GetMaxTextureSlotCount(), Renderer2DData::MaxTextureSlots);
+
+		s_Data->Batches.clear();
+		s_Data->BatchTextures.clear();
+
+		QuadBatch batch;
+		uint32_t stamp = ++s_Data->BatchStamp;
+
+		auto split = [&](uint32_t first) {
+			batch.QuadCount = first - batch.FirstQuad;
+			s_Data->Batches.push_back(batch);
+
+			batch = QuadBatch{ first, 0, (uint32_t)s_Data->BatchTextures.size(), 0, batch.Pass };
+			stamp = ++s_Data->BatchStamp;
+		};
+
+		for (uint32_t i = 0; i < quadCount; i++)
+		{
+			const QuadSortEntry& entry = s_Data->SortEntries[i];
+
+			// Passes are drawn with different state
+			uint32_t pass = (uint32_t)(entry.Key >> Renderer2DData::SortKeyPassShift);
+			if (pass != batch.Pass)
+			{
+				if (i != batch.FirstQuad)
+					split(i);
+
+				batch.Pass = pass;
+			}
+
+			// Patch a local copy, destination is write-only mapped memory
+			QuadType quad = quads[entry.Index];
+
+			if (uint32_t textureID = s_Data->QuadTextureIDs[entry.Index])
+			{
+				uint32_t shaderFlags = s_Data->TextureDescriptorEntries[GetTextureDescriptor(quad)].ShaderFlags;
+
+				TextureBindState& state = s_Data->TextureBindStates[textureID];
+				if (state.Paged)
+				{
+					if (batch.TextureCount != 0)
+						split(i);
+
+					batch.Paged = true;
+					SetTextureSlot(quad, 1 << Renderer2DData::TextureSlotShift);
+				}
+				else
+				{
+					if (batch.Paged)
+						split(i);
+
+					if (state.BatchStamp != stamp)
+					{
+						if (batch.TextureCount == maxSlots)
+						{
+							Renderer2D::GetStatistics().SlotOverflowSplits++;
+							split(i);
+						}
+
+						state.BatchStamp = stamp;
+						state.Slot = batch.TextureCount++;
+						s_Data->BatchTextures.push_back(state.Texture);
+					}
+
+					SetTextureSlot(quad, (state.Slot + 1) << Renderer2DData::TextureSlotShift);
+				}
+
+				batch.ShaderFlags |= shaderFlags;
+			}
+
+			destination[i] = quad;
+		}
+
+		batch.QuadCount = quadCount - batch.FirstQuad;
+		s_Data->Batches.push_back(batch);
+	}
+
+	static const Ref<Shader>& GetBatchShader(const QuadBatch& batch, bool instanced)
+	{
+		uint32_t flags = batch.ShaderFlags;
+		if (batch.Paged)
+			flags |= BatchShader_Paged;
+		if (instanced)
+			flags |= BatchShader_Instanced;
+		return GetBatchShader(flags);
+	}
+
+	static void BindBatchTextures(const QuadBatch& batch)
+	{
+		if (batch.Paged)
+		{
+			TextureManager::GetPages()->Bind(0);
+			return;
+		}
+
+		for (uint32_t slot = 0; slot < batch.TextureCount; slot++)
+			s_Data->BatchTextures[batch.FirstTexture + slot]->Bind(slot);
+	}
+
+	/////////////////////////////////////////////////////////
+	// Retained Quads ///////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	struct RetainedQuadSlot
+	{
+		// Kept to acquire the descriptor again when the descriptor table is cleared
+		Ref<Texture2D> Texture = nullptr;
+		TexturedQuadExtraData ExtraData;
+
+		Ref<GAPI::Texture2D> GPUTexture = nullptr; // Last texture, kept while hidden so showing the slot again needs no rebuild
+		uint32_t SlotBits = 0; // (Texture slot + 1) << TextureSlotShift in its batch, valid unless BatchesDirty
+		bool Used = false;
+		bool Dirty = false;
+	};
+
+	struct RetainedQuadBatchData
+	{
+		Vector<InstanceVertex> Instances; // CPU copy of the GPU buffer
+		Vector<RetainedQuadSlot> Slots;
+		Vector<uint32_t> FreeSlots;
+		Vector<uint32_t> DirtySlots;
+
+		// Distinct textures of the slots and how many slots show each, marked used instead of every slot
+		UnorderedMap<Texture2D*, uint32_t> SlotTextureCounts;
+
+		bool BatchesDirty = false; // A slot references a texture which is not in its batch
+		bool FullUpload = true;
+		uint32_t TextureDescriptorEpoch = 0;
+		uint32_t MappingEpoch = 0; // TextureManager's, textures moved or evicted since
+
+		Ref<VertexBuffer> instanceBuffer = nullptr;
+		Ref<VertexArray> vertexArray = nullptr;
+		uint32_t Capacity = 0;
+
+		Vector<QuadBatch> Batches;
+		Vector<Ref<GAPI::Texture2D>> BatchTextures;
+	};
+
+	static void MarkRetainedSlotDirty(RetainedQuadBatchData& data, uint32_t slot)
+	{
+		if (!data.Slots[slot].Dirty)
+		{
+			data.Slots[slot].Dirty = true;
+			data.DirtySlots.push_back(slot);
+		}
+	}
+
+	static void WriteRetainedQuad(RetainedQuadBatchData& data, uint32_t slot, const Mat4x4& transform, const Color& tint, uint32_t texDescriptor)
+	{
+		InstanceVertex& instance = data.Instances[slot];
+		instance.a_TransformX = Vector3(transform[0]);
+		instance.a_TransformY = Vector3(transform[1]);
+		instance.a_TransformW = Vector3(transform[3]);
+		instance.a_Color = PackColor(tint);
+		instance.a_TexDescriptor = texDescriptor;
+
+		MarkRetainedSlotDirty(data, slot);
+	}
+
+	static void SetRetainedSlotSource(RetainedQuadBatchData& data, RetainedQuadSlot& slot, const Ref<Texture2D>& texture)
+	{
+		if (slot.Texture == texture)
+			return;
+
+		if (slot.Texture)
+		{
+			auto it = data.SlotTextureCounts.find(slot.Texture.get());
+			if (--it->second == 0)
+				data.SlotTextureCounts.erase(it);
+		}
+
+		if (texture)
+			data.SlotTextureCounts[texture.get()]++;
+
+		slot.Texture = texture;
+	}
+
+	static void SetRetainedSlotTexture(RetainedQuadBatchData& data, RetainedQuadSlot& slot, const Ref<GAPI::Texture2D>& texture)
+	{
+		if (slot.GPUTexture != texture)
+		{
+			slot.GPUTexture = texture;
+			data.BatchesDirty = true;
+		}
+	}
+
+	RetainedQuadBatch::RetainedQuadBatch()
+		: m_Data(CreateScope<RetainedQuadBatchData>())
+	{
+		m_Data->instanceBuffer = VertexBuffer::Create();
+		m_Data->instanceBuffer->SetLayout(InstanceVertexLayout());
+
+		m_Data->vertexArray = VertexArray::Create();
+		m_Data->vertexArray->AddVertexBuffer(m_Data->instanceBuffer, 1);
+
+		m_Data->TextureDescriptorEpoch = s_Data->TextureDescriptorEpoch;
+		m_Data->MappingEpoch = TextureManager::GetMappingEpoch();
+	}
+
+	RetainedQuadBatch::~RetainedQuadBatch()
+	{
+	}
+
+	uint32_t RetainedQuadBatch::AllocateSlot()
+	{
+		uint32_t slot;
+		if (!m_Data->FreeSlots.empty())
+		{
+			slot = m_Data->FreeSlots.back();
+			m_Data->FreeSlots.pop_back();
+		}
+		else
+		{
+			slot = (uint32_t)m_Data->Slots.size();
+			m_Data->Slots.emplace_back();
+			m_Data->Instances.emplace_back();
+			MarkRetainedSlotDirty(*m_Data, slot);
+		}
+
+		m_Data->Slots[slot].Used = true;
+		return slot;
+	}
+
+	void RetainedQuadBatch::FreeSlot(uint32_t slot)
+	{
+		OE_CORE_ASSERT(m_Data->Slots[slot].Used, "Slot is not allocated!");
+
+		HideQuad(slot);
+		m_Data->Slots[slot].Used = false;
+		m_Data->Slots[slot].GPUTexture = nullptr;
+		m_Data->FreeSlots.push_back(slot);
+	}
+
+	bool RetainedQuadBatch::SetQuad(uint32_t slot, const Mat4x4& transform, const Color& color, float alphaClippingThreshold)
+	{
+		if (color.a <= alphaClippingThreshold)
+		{
+			HideQuad(slot);
+			return true;
+		}
+
+		if (color.a < 1.0f)
+		{
+			HideQuad(slot);
+			return false;
+		}
+
+		// Untextured, the slot gives up its place in the batch textures
+		SetRetainedSlotSource(*m_Data, m_Data->Slots[slot], nullptr);
+		SetRetainedSlotTexture(*m_Data, m_Data->Slots[slot], nullptr);
+		WriteRetainedQuad(*m_Data, slot, transform, color, 0);
+		return true;
+	}
+
+	bool RetainedQuadBatch::SetQuad(uint32_t slot, const Mat4x4& transform, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	{
+		if (!texture || texture->GetType() == TextureType::Placeholder ||
+			extraData.AlphaClipThreshold >= 1.0f || extraData.Tint.a <= extraData.AlphaClipThreshold)
+		{
+			HideQuad(slot);
+			return true;
+		}
+
+		uint32_t descriptor = AcquireTextureDescriptor(texture, extraData);
+		if (descriptor == Renderer2DData::InvalidTextureDescriptor)
+		{
+			HideQuad(slot);
+			return true;
+		}
+
+		const TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries[descriptor];
+
+		if (extraData.Tint.a < 1.0f || entry.HasAlpha)
+		{
+			HideQuad(slot);
+			return false;
+		}
+
+		RetainedQuadSlot& retainedSlot = m_Data->Slots[slot];
+		SetRetainedSlotSource(*m_Data, retainedSlot, texture);
+		retainedSlot.ExtraData = extraData;
+		SetRetainedSlotTexture(*m_Data, retainedSlot, entry.GPUTexture);
+
+		WriteRetainedQuad(*m_Data, slot, transform, extraData.Tint, descriptor | retainedSlot.SlotBits);
+		return true;
+	}
+
+	void RetainedQuadBatch::HideQuad(uint32_t slot)
+	{
+		SetRetainedSlotSource(*m_Data, m_Data->Slots[slot], nullptr);
+
+		// Zero sized quad, rasterizes nothing
+		m_Data->Instances[slot] = InstanceVertex();
+		MarkRetainedSlotDirty(*m_Data, slot);
+	}
+
+	uint32_t RetainedQuadBatch::GetSlotCount() const
+	{
+		return (uint32_t)m_Data->Slots.size();
+	}
+
+	// Descriptor indices of the batch are invalid after the descriptor table is cleared
+	static void ReacquireRetainedDescriptors(RetainedQuadBatchData& data)
+	{
+		for (uint32_t i = 0; i < (uint32_t)data.Slots.size(); i++)
+		{
+			RetainedQuadSlot& slot = data.Slots[i];
+			if (!slot.Texture)
+				continue;
+
+			uint32_t descriptor = AcquireTextureDescriptor(slot.Texture, slot.ExtraData);
+			if (descriptor == Renderer2DData::InvalidTextureDescriptor)
+			{
+				// Shown again by its next SetQuad
+				data.Instances[i] = InstanceVertex();
+				continue;
+			}
+
+			SetRetainedSlotTexture(data, slot, s_Data->TextureDescriptorEntries[descriptor].GPUTexture);
+			data.Instances[i].a_TexDescriptor = descriptor | slot.SlotBits;
+		}
+
+		data.TextureDescriptorEpoch = s_Data->TextureDescriptorEpoch;
+		data.MappingEpoch = TextureManager::GetMappingEpoch();
+		data.FullUpload = true;
+	}
+
+	// Same greedy split as BuildBatches, over slot order; only needed when the texture set changes
+	static void RebuildRetainedBatches(RetainedQuadBatchData& data)
+	{
+		uint32_t maxSlots = std::min(RenderCommand::GetMaxTextureSlotCount(), Renderer2DData::MaxTextureSlots);
+
+		data.Batches.clear();
+		data.BatchTextures.clear();
+
+		QuadBatch batch;
+		uint32_t stamp = ++s_Data->BatchStamp;
+
+		auto split = [&](uint32_t first) {
+			batch.QuadCount = first - batch.FirstQuad;
+			data.Batches.push_back(batch);
+
+			batch = QuadBatch{ first, 0, (uint32_t)data.BatchTextures.size(), 0 };
+			stamp = ++s_Data->BatchStamp;
+		};
+
+		for (uint32_t i = 0; i < (uint32_t)data.Slots.size(); i++)
+		{
+			RetainedQuadSlot& slot = data.Slots[i];
+			if (!slot.GPUTexture)
+				continue;
+
+			uint32_t textureID = slot.GPUTexture->GetRendererID();
+			if (textureID >= s_Data->TextureBindStates.size())
+				s_Data->TextureBindStates.resize(textureID + 1);
+
+			if (slot.GPUTexture->GetArrayLayer() != -1)
+			{
+				if (batch.TextureCount != 0)
+					split(i);
+
+				batch.Paged = true;
+				slot.SlotBits = 1 << Renderer2DData::TextureSlotShift;
+			}
+			else
+			{
+				if (batch.Paged)
+					split(i);
+
+				TextureBindState& state = s_Data->TextureBindStates[textureID];
+				if (state.BatchStamp != stamp)
+				{
+					if (batch.TextureCount == maxSlots)
+						split(i);
+
+					state.BatchStamp = stamp;
+					state.Slot = batch.TextureCount++;
+					data.BatchTextures.push_back(slot.GPUTexture);
+				}
+
+				slot.SlotBits = (state.Slot + 1) << Renderer2DData::TextureSlotShift;
+			}
+
+			// Hidden slots keep their bits for SetQuad, their zeroed instance stays untouched
+			if (slot.Texture)
+				data.Instances[i].a_TexDescriptor = (data.Instances[i].a_TexDescriptor & (Renderer2DData::MaxTextureDescriptors - 1)) | slot.SlotBits;
+		}
+
+		batch.QuadCount = (uint32_t)data.Slots.size() - batch.FirstQuad;
+		data.Batches.push_back(batch);
+
+		data.BatchesDirty = false;
+		data.FullUpload = true;
+	}
+
+	static void UploadRetainedQuads(RetainedQuadBatchData& data)
+	{
+		// Retained quads are drawn without acquiring, their textures would look cold
+		if (TextureManager::GetMemoryBudget())
+		{
+			for (const auto& [texture, slotCount] : data.SlotTextureCounts)
+				TextureManager::MarkUsed(*texture);
+		}
+
+		if (data.TextureDescriptorEpoch != s_Data->TextureDescriptorEpoch || data.MappingEpoch != TextureManager::GetMappingEpoch())
+			ReacquireRetainedDescriptors(data);
+
+		if (data.BatchesDirty)
+			RebuildRetainedBatches(data);
+
+		uint32_t slotCount = (uint32_t)data.Slots.size();
+
+		// New slots are either untextured or made the batches dirty, so extending the last batch is enough
+		if (data.Batches.empty())
+			data.Batches.push_back(QuadBatch{ 0, slotCount, 0, 0 });
+		else
+			data.Batches.back().QuadCount = slotCount - data.Batches.back().FirstQuad;
+
+		if (data.Capacity < slotCount)
+		{
+			data.Capacity = std::max(slotCount, 2 * data.Capacity);
+			data.instanceBuffer->AllocateStorage(data.Capacity * sizeof(InstanceVertex));
+			data.FullUpload = true;
+		}
+
+		auto upload = [&data](uint32_t first, uint32_t count) {
+			data.instanceBuffer->BufferSubData((const float*)(data.Instances.data() + first), count * sizeof(InstanceVertex), first * sizeof(InstanceVertex));
+			Renderer2D::GetStatistics().RetainedUploadCount += count;
+			Renderer2D::GetStatistics().UploadedBytes += count * sizeof(InstanceVertex);
+		};
+
+		if (data.FullUpload)
+		{
+			if (slotCount)
+				upload(0, slotCount);
+		}
+		else if (!data.DirtySlots.empty())
+		{
+			// Merge adjacent dirty slots into ranges
+			std::sort(data.DirtySlots.begin(), data.DirtySlots.end());
+
+			uint32_t first = data.DirtySlots[0];
+			uint32_t last = first;
+			for (size_t i = 1; i < data.DirtySlots.size(); i++)
+			{
+				uint32_t slot = data.DirtySlots[i];
+				if (slot != last + 1)
+				{
+					upload(first, last - first + 1);
+					first = slot;
+				}
+				last = slot;
+			}
+			upload(first, last - first + 1);
+		}
+
+		for (uint32_t slot : data.DirtySlots)
+			data.Slots[slot].Dirty = false;
+
+		data.DirtySlots.clear();
+		data.FullUpload = false;
+	}
+
+	static void DrawRetainedQuads(const RetainedQuadBatchData& data)
+	{
+		data.vertexArray->Bind();
+
+		for (const auto& batch : data.Batches)
+		{
+			if (batch.QuadCount == 0)
+				continue;
+
+			// Slots change texture or sampling without a rebuild, so the generic permutation is kept
+			GetBatchShader(BatchShader_Generic | BatchShader_Instanced | (batch.Paged ? BatchShader_Paged : 0))->Bind();
+
+			if (batch.Paged)
+				TextureManager::GetPages()->Bind(0);
+			else
+			{
+				for (uint32_t slot = 0; slot < batch.TextureCount; slot++)
+					data.BatchTextures[batch.FirstTexture + slot]->Bind(slot);
+			}
+
+			RenderCommand::DrawInstanced(data.vertexArray, 6, batch.QuadCount, batch.FirstQuad);
+		}
+
+		Renderer2D::GetStatistics().DrawCalls += (uint32_t)data.Batches.size();
+		Renderer2D::GetStatistics().RetainedQuadCount += (uint32_t)data.Slots.size();
+	}
+
+	// Captures have no retained batches, the visible slots are recorded as the quads they draw
+	static void RecordRetainedQuads(const RetainedQuadBatchData& data)
+	{
+		for (uint32_t i = 0; i < (uint32_t)data.Slots.size(); i++)
+		{
+			const RetainedQuadSlot& slot = data.Slots[i];
+			const InstanceVertex& instance = data.Instances[i];
+
+			// Hidden slots are zero sized
+			if (!slot.Used || (instance.a_TransformX == Vector3(0.0f) && instance.a_TransformY == Vector3(0.0f)))
+				continue;
+
+			Mat4x4 transform(
+				Vector4(instance.a_TransformX, 0.0f), Vector4(instance.a_TransformY, 0.0f),
+				Vector4(0.0f, 0.0f, 1.0f, 0.0f), Vector4(instance.a_TransformW, 1.0f)
+			);
+
+			if (slot.Texture)
+				Renderer2DCapture::RecordQuad(transform, slot.Texture, slot.ExtraData);
+			else
+				Renderer2DCapture::RecordQuad(transform, UnpackColor(instance.a_Color), 0.0f);
+		}
+	}
+
+	void Renderer2D::DrawRetained(RetainedQuadBatch& batch)
+	{
+		if (Renderer2DCapture::IsRecording())
+			RecordRetainedQuads(*batch.m_Data);
+
+		s_Data->RetainedBatches.push_back(batch.m_Data.get());
+	}
+
+	/////////////////////////////////////////////////////////
+	// Flush ////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	/**
+	 * Adds the CPU time since the last flush (the DrawQuad calls) to SubmitMilliseconds
+	 * and its own lifetime to FlushMilliseconds.
+	 */
+	struct FlushTimer
+	{
+		FlushTimer()
+			: Start(Time::GetTimeDouble())
+		{
+			Renderer2D::GetStatistics().SubmitMilliseconds += 1000.0 * (Start - s_Data->SubmitStart);
+		}
+
+		~FlushTimer()
+		{
+			double end = Time::GetTimeDouble();
+			Renderer2D::GetStatistics().FlushMilliseconds += 1000.0 * (end - Start);
+			s_Data->SubmitStart = end;
+		}
+
+		double Start;
+	};
+
+	static void BuildInstances()
+	{
+		uint32_t instanceCount = s_Data->FlushingQuadCount;
+
+		// Grow GPU Buffer
+		if (s_Data->InstanceCapacity < instanceCount)
+		{
+			CreateInstanceStream(std::max(instanceCount, 2 * s_Data->InstanceCapacity));
+			Renderer2D::GetStatistics().BufferGrowths++;
+		}
+
+		// Write sorted instances directly to mapped memory
+		InstanceVertex* instances = (InstanceVertex*)s_Data->instanceStream->Map(instanceCount * sizeof(InstanceVertex), sizeof(InstanceVertex));
+		BuildBatches(instances, s_Data->Instances);
+		s_Data->instanceStream->Unmap();
+		Renderer2D::GetStatistics().UploadedBytes += instanceCount * sizeof(InstanceVertex);
+
+		s_Data->GeometryBase = s_Data->instanceStream->GetMappedOffset() / sizeof(InstanceVertex);
+	}
+
+	static void BuildVertices()
+	{
+		uint32_t quadCount = s_Data->FlushingQuadCount;
+
+		// Grow GPU Buffers
+		if (s_Data->QuadCapacity < quadCount)
+		{
+			CreateVertexStream(std::max(quadCount, 2 * s_Data->QuadCapacity));
+			Renderer2D::GetStatistics().BufferGrowths++;
+		}
+
+		// Write sorted vertices directly to mapped memory
+		DrawQuadVertices* vertices = (DrawQuadVertices*)s_Data->vertexStream->Map(quadCount * sizeof(DrawQuadVertices), sizeof(DrawQuadVertices));
+		BuildBatches(vertices, s_Data->Vertices);
+		s_Data->vertexStream->Unmap();
+		Renderer2D::GetStatistics().UploadedBytes += quadCount * sizeof(DrawQuadVertices);
+
+		s_Data->GeometryBase = s_Data->vertexStream->GetMappedOffset() / sizeof(Vertex);
+	}
+
+	// Sorts pending quads and writes them to the GPU, the result can be drawn any number of times
+	static void BuildGeometry()
+	{
+		FlushTimer timer;
+
+		s_Data->Batches.clear();
+		s_Data->BatchTextures.clear();
+
+		// May write descriptors, so before UploadTextureDescriptors
+		for (auto retained : s_Data->RetainedBatches)
+			UploadRetainedQuads(*retained);
+
+		UploadTextureDescriptors();
+
+		if (s_Data->FlushingQuadCount == 0) // Nothing to draw
+			return;
+
+		RadixSortEntries(s_Data->SortEntries, s_Data->SortScratch);
+
+		s_Data->GeometryInstanced = s_Data->InstancedRendering;
+		if (s_Data->GeometryInstanced)
+			BuildInstances();
+		else
+			BuildVertices();
+
+		Renderer2D::GetStatistics().BatchCount += (uint32_t)s_Data->Batches.size();
+	}
+
+	static BlendMode GetPassBlendMode(uint32_t pass)
+	{
+		// Every fragment adds up
+		if (s_Data->OverdrawDebug)
+			return BlendMode::Additive;
+
+		return pass == QuadPass_Transparent ? BlendMode::Alpha : BlendMode::None;
+	}
+
+	// Draws the built geometry through the camera in s_Data->ViewProjectionMatrix
+	static void DrawBuiltGeometry()
+	{
+		if (s_Data->Batches.empty() && s_Data->RetainedBatches.empty())
+			return;
+
+		FlushTimer timer;
+		TextureManager::GenerateDirtyMipmaps();
+		RenderCommand::BeginGPUTimer(s_Data->View);
+
+		CameraData camera{ s_Data->ViewProjectionMatrix };
+		s_Data->cameraBuffer->SetData(&camera, sizeof(CameraData));
+		Renderer2D::GetStatistics().UploadedBytes += sizeof(CameraData);
+		s_Data->cameraBuffer->Bind(Renderer2DData::CameraBinding);
+
+		s_Data->textureDescriptorBuffer->Bind(Renderer2DData::TextureDescriptorsBinding);
+
+		if (s_Data->OverdrawDebug)
+			RenderCommand::BeginSampleCount();
+
+		if (!s_Data->RetainedBatches.empty())
+		{
+			RenderCommand::SetBlendMode(GetPassBlendMode(QuadPass_Opaque));
+			for (auto retained : s_Data->RetainedBatches)
+				DrawRetainedQuads(*retained);
+		}
+
+		if (s_Data->GeometryInstanced)
+		{
+			s_Data->instanceVertexArray->Bind();
+
+			for (const auto& batch : s_Data->Batches)
+			{
+				RenderCommand::SetBlendMode(GetPassBlendMode(batch.Pass));
+				GetBatchShader(batch, true)->Bind();
+				BindBatchTextures(batch);
+				RenderCommand::DrawInstanced(s_Data->instanceVertexArray, 6, batch.QuadCount, s_Data->GeometryBase + batch.FirstQuad);
+			}
+		}
+		else
+		{
+			s_Data->vertexArray->Bind();
+
+			for (const auto& batch : s_Data->Batches)
+			{
+				RenderCommand::SetBlendMode(GetPassBlendMode(batch.Pass));
+				GetBatchShader(batch, false)->Bind();
+				BindBatchTextures(batch);
+				RenderCommand::DrawIndexed(s_Data->vertexArray, 6 * batch.QuadCount, s_Data->GeometryBase + 4 * batch.FirstQuad);
+			}
+		}
+
+		Renderer2D::GetStatistics().DrawCalls += (uint32_t)s_Data->Batches.size();
+
+		if (s_Data->OverdrawDebug)
+			Renderer2D::GetStatistics().SamplesPassed += RenderCommand::EndSampleCount();
+
+		// Default state of RendererAPI::Init, expected by everything else
+		RenderCommand::SetBlendMode(BlendMode::Alpha);
+
+		RenderCommand::EndGPUTimer();
+	}
+
+	void Renderer2D::Flush()
+	{
+		if (s_Data->FlushingQuadCount == 0 && s_Data->RetainedBatches.empty()) // Nothing to draw
+			return;
+
+		OE_CORE_ASSERT(s_Data->HasCamera, "Geometry recorded by BeginGeometry can't be flushed without a camera!");
+
+		BuildGeometry();
+		DrawBuiltGeometry();
+	}
+
+	void Renderer2D::BeginGeometry()
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordBeginGeometry();
+
+		ResetGeometry();
+	}
+
+	void Renderer2D::EndGeometry()
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordEndGeometry();
+
+		CountFlush(FlushReason_EndScene);
+		BuildGeometry();
+	}
+
+	void Renderer2D::DrawGeometry(const Mat4x4& viewProjectionMatrix)
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordDrawGeometry(viewProjectionMatrix);
+
+		s_Data->ViewProjectionMatrix = viewProjectionMatrix;
+		DrawBuiltGeometry();
+	}
+
+	void Renderer2D::DrawGeometry(const Mat4x4& viewMatrix, const Camera& camera)
+	{
+		DrawGeometry(camera.GetProjection() * viewMatrix);
+	}
+
+	void Renderer2D::FlushAndReset()
+	{
+		Flush();
+		Reset();
+	}
+
+	/////////////////////////////////////////////////////////
+	// FlatColor Quad ///////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	void Renderer2D::DrawQuad(const Vector2& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold)
+	{
+		DrawQuad(Vector3(position, 0.0f), rotation, size, color, alphaClippingThreshold);
+	}
+
+	void Renderer2D::DrawQuad(const Vector3& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold)
+	{
+		DrawQuad(MakeQuadTransform(position, rotation, size), color, alphaClippingThreshold);
+	}
+
+	void Renderer2D::DrawQuad(const Mat4x4& transform, const Color& color, float alphaClippingThreshold)
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordQuad(transform, color, alphaClippingThreshold);
+
+		if (color.a <= alphaClippingThreshold)
+			return;
+
+		QuadPass pass = color.a < 1.0f ? QuadPass_Transparent : QuadPass_Opaque;
+
+		InsertQuad(pass, transform, color, -1, 0);
+
+		s_Statistics.QuadCount++;
+		s_Data->FlushingQuadCount++;
+	}
+
+	void Renderer2D::DrawQuads(const QuadInstance* quads, uint32_t count, float alphaClippingThreshold)
+	{
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordQuads(quads, count, alphaClippingThreshold);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const QuadInstance& quad = quads[i];
+			if (quad.Tint.a <= alphaClippingThreshold)
+				continue;
+
+			QuadPass pass = quad.Tint.a < 1.0f ? QuadPass_Transparent : QuadPass_Opaque;
+			InsertQuad(pass, MakeQuadTransform(quad.Position, quad.Rotation, quad.Size), quad.Tint, -1, 0);
+
+			s_Statistics.QuadCount++;
+			s_Data->FlushingQuadCount++;
+		}
+	}
+
+	/////////////////////////////////////////////////////////
+	// Textured Quad ////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	void Renderer2D::DrawQuad(const Vector2& position, float rotation, const Vector2& size, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	{
+		DrawQuad(Vector3(position, 0.0f), rotation, size, texture, extraData);
+	}
+
+	void Renderer2D::DrawQuad(const Vector3& position, float rotation, const Vector2& size, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	{
+		DrawQuad(MakeQuadTransform(position, rotation, size), texture, extraData);
+	}
+
+	void Renderer2D::DrawQuad(const Mat4x4& transform, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	{
+		if (!texture || texture->GetType() == TextureType::Placeholder)
+			return;
+
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordQuad(transform, texture, extraData);
+
+		if (extraData.AlphaClipThreshold >= 1.0f || extraData.Tint.a <= extraData.AlphaClipThreshold)
+			return;
+
+		uint32_t descriptor = AcquireTextureDescriptor(texture, extraData);
+		if (descriptor == Renderer2DData::InvalidTextureDescriptor)
+			return;
+
+		const TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries[descriptor];
+
+		uint32_t textureID = RegisterPendingTexture(entry);
+
+		QuadPass pass = GetTexturedQuadPass(entry, extraData.Tint, extraData.AlphaClipThreshold);
+
+		InsertQuad(pass, transform, extraData.Tint, descriptor, textureID);
+
+		s_Statistics.QuadCount++;
+		s_Data->FlushingQuadCount++;
+	}
+
+	void Renderer2D::DrawQuads(const QuadInstance* quads, uint32_t count, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData)
+	{
+		if (!texture || texture->GetType() == TextureType::Placeholder || count == 0)
+			return;
+
+		if (Renderer2DCapture::IsRecording())
+			Renderer2DCapture::RecordQuads(quads, count, texture, extraData);
+
+		if (extraData.AlphaClipThreshold >= 1.0f)
+			return;
+
+		// Resolved once for all quads
+		uint32_t descriptor = AcquireTextureDescriptor(texture, extraData);
+		if (descriptor == Renderer2DData::InvalidTextureDescriptor)
+			return;
+
+		const TextureDescriptorEntry& entry = s_Data->TextureDescriptorEntries[descriptor];
+
+		uint32_t textureID = RegisterPendingTexture(entry);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const QuadInstance& quad = quads[i];
+			if (quad.Tint.a <= extraData.AlphaClipThreshold)
+				continue;
+
+			QuadPass pass = GetTexturedQuadPass(entry, quad.Tint, extraData.AlphaClipThreshold);
+			InsertQuad(pass, MakeQuadTransform(quad.Position, quad.Rotation, quad.Size), quad.Tint, descriptor, textureID);
+
+			s_Statistics.QuadCount++;
+			s_Data->FlushingQuadCount++;
+		}
 	}
 }
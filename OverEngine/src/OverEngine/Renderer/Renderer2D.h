@@ -28,6 +28,47 @@ namespace OverEngine
 		std::pair<bool, Color> TextureBorderColor{ false, Color(1.0f) };
 	};
 
+	// Sprite description used by Renderer2D::DrawQuads
+	struct QuadInstance
+	{
+		Vector3 Position = Vector3(0.0f);
+		float Rotation = 0.0f; // Radians around Z axis
+		Vector2 Size = Vector2(1.0f);
+		Color Tint = Color(1.0f);
+	};
+
+	struct RetainedQuadBatchData;
+
+	/**
+	 * Quads which keep a persistent slot in a GPU buffer between frames.
+	 * Only slots written since the last upload are sent to the GPU (as merged dirty ranges).
+	 * Slots are drawn in slot order without sorting, so only opaque quads are accepted.
+	 * Texture changes (e.g. atlas repacking) are picked up when the slot is set again.
+	 */
+	class RetainedQuadBatch
+	{
+	public:
+		RetainedQuadBatch();
+		~RetainedQuadBatch();
+
+		uint32_t AllocateSlot();
+		void FreeSlot(uint32_t slot);
+
+		/**
+		 * Returns false if the quad is transparent; the slot is hidden and the
+		 * quad should be drawn through Renderer2D::DrawQuad to be sorted.
+		 */
+		bool SetQuad(uint32_t slot, const Mat4x4& transform, const Color& color, float alphaClippingThreshold = 0.0f);
+		bool SetQuad(uint32_t slot, const Mat4x4& transform, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData = TexturedQuadExtraData());
+		void HideQuad(uint32_t slot);
+
+		uint32_t GetSlotCount() const;
+	private:
+		Scope<RetainedQuadBatchData> m_Data;
+
+		friend class Renderer2D;
+	};
+
 	class Renderer2D
 	{
 	public:
@@ -37,6 +78,36 @@ namespace OverEngine
 
 		static void Reset();
 
+		/**
+		 * Once per frame, Application::Run calls it before updating the layers. Resets the statistics and
+		 * reads the GPU times of the frame RendererAPI::GPUTimerLatency frames ago. Each BeginScene /
+		 * BeginGeometry after it starts a view of the frame, timed on its own.
+		 */
+		static void BeginFrame();
+
+		/**
+		 * Instanced rendering uploads one compact record per quad instead of four vertices.
+		 * Switching modes flushes pending quads.
+		 */
+		static void SetInstancedRendering(bool enabled);
+		static bool IsInstancedRendering();
+
+		/**
+		 * Opaque quads are always drawn front to back without blending.
+		 * With early depth, alpha clipped sprites (texture with alpha, AlphaClipThreshold > 0 and an opaque tint)
+		 * are treated as cutouts: drawn front to back in their own depth writing pass after the opaque quads
+		 * instead of being sorted back to front with the transparent ones.
+		 */
+		static void SetEarlyDepth(bool enabled);
+		static bool IsEarlyDepth();
+
+		/**
+		 * Debug mode; every fragment adds a constant to the color buffer (brighter means more overdraw)
+		 * and Statistics::SamplesPassed counts the fragments written. Waits for the GPU after each draw.
+		 */
+		static void SetOverdrawDebug(bool enabled);
+		static bool IsOverdrawDebug();
+
 		static void BeginScene(const Mat4x4& viewProjectionMatrix);
 		static void BeginScene(const Mat4x4& viewMatrix, const Camera& camera);
 		static void BeginScene(const Mat4x4& viewMatrix, const Mat4x4& projectionMatrix);
@@ -45,6 +116,21 @@ namespace OverEngine
 		static void Flush();
 		static void FlushAndReset();
 
+		/**
+		 * Quads are stored in world space and projected by a camera uniform buffer, so one set of
+		 * geometry can be drawn from several cameras (split screen, minimaps, editor viewport).
+		 * Quads submitted between BeginGeometry and EndGeometry are sorted and uploaded once,
+		 * then each DrawGeometry call only costs the camera upload and the draw calls.
+		 * Built geometry stays valid until the next BeginGeometry / BeginScene.
+		 */
+		static void BeginGeometry();
+		static void EndGeometry();
+		static void DrawGeometry(const Mat4x4& viewProjectionMatrix);
+		static void DrawGeometry(const Mat4x4& viewMatrix, const Camera& camera);
+
+		// Draws batch with the current geometry, before the immediate quads. Dirty slots are uploaded once per build
+		static void DrawRetained(RetainedQuadBatch& batch);
+
 		inline static void DrawQuad(const Vector2& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold = 0.0f);
 		static void DrawQuad(const Vector3& position, float rotation, const Vector2& size, const Color& color, float alphaClippingThreshold = 0.0f);
 		static void DrawQuad(const Mat4x4& transform, const Color& color, float alphaClippingThreshold = 0.0f);
@@ -53,12 +139,51 @@ namespace OverEngine
 		static void DrawQuad(const Vector3& position, float rotation, const Vector2& size, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData = TexturedQuadExtraData());
 		static void DrawQuad(const Mat4x4& transform, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData = TexturedQuadExtraData());
 
+		/**
+		 * Submits many quads in one call, per quad work is reduced to building the transform and expanding the corners.
+		 * The textured overload resolves texture state once; QuadInstance::Tint replaces extraData.Tint.
+		 */
+		static void DrawQuads(const QuadInstance* quads, uint32_t count, float alphaClippingThreshold = 0.0f);
+		static void DrawQuads(const QuadInstance* quads, uint32_t count, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData = TexturedQuadExtraData());
+
+		inline static void DrawQuads(const Vector<QuadInstance>& quads, float alphaClippingThreshold = 0.0f) { DrawQuads(quads.data(), (uint32_t)quads.size(), alphaClippingThreshold); }
+		inline static void DrawQuads(const Vector<QuadInstance>& quads, Ref<Texture2D> texture, const TexturedQuadExtraData& extraData = TexturedQuadExtraData()) { DrawQuads(quads.data(), (uint32_t)quads.size(), texture, extraData); }
+
+		// Why pending quads were flushed, see Statistics::Flushes
+		enum FlushReason
+		{
+			FlushReason_EndScene = 0,       // EndScene / EndGeometry
+			FlushReason_DescriptorOverflow, // Texture descriptor table ran out of entries
+			FlushReason_ModeSwitch,         // SetInstancedRendering with pending quads
+			FlushReason_Count
+		};
+
 		struct Statistics
 		{
 			void Reset()
 			{
 				QuadCount = 0;
 				DrawCalls = 0;
+				RetainedQuadCount = 0;
+				RetainedUploadCount = 0;
+				UploadedBytes = 0;
+				VisibleSpriteCount = 0;
+				CulledSpriteCount = 0;
+				SamplesPassed = 0;
+
+				BatchCount = 0;
+				SlotOverflowSplits = 0;
+				BufferGrowths = 0;
+				for (auto& flushes : Flushes)
+					flushes = 0;
+
+				SubmitMilliseconds = 0.0;
+				FlushMilliseconds = 0.0;
+				GPUMilliseconds = 0.0;
+
+				ViewCount = 0;
+				for (auto& milliseconds : ViewGPUMilliseconds)
+					milliseconds = 0.0;
 			}
 
 			uint32_t GetIndexCount() { return 6 * QuadCount; }
@@ -66,6 +191,35 @@ namespace OverEngine
 
 			uint32_t QuadCount;
 			uint32_t DrawCalls;
+
+			uint32_t RetainedQuadCount; // Slots of the drawn retained batches
+			uint32_t RetainedUploadCount; // Retained slots uploaded this frame
+
+			uint64_t UploadedBytes; // Vertices, indices, descriptors and camera data written to GPU buffers
+
+			// Sprites tested against the camera bounds by Scene::RenderSprites
+			uint32_t VisibleSpriteCount;
+			uint32_t CulledSpriteCount;
+
+			uint64_t SamplesPassed; // Only counted in overdraw debug mode, divide by the pixel count for the average overdraw
+
+			uint32_t BatchCount; // Batches built from the pending quads
+			uint32_t SlotOverflowSplits; // Batches split because they ran out of texture slots
+			uint32_t BufferGrowths; // Vertex / instance streams recreated to fit the pending quads
+			uint32_t Flushes[FlushReason_Count];
+
+			// CPU time of the DrawQuad calls, and of sorting, batching, uploading and submitting draws
+			double SubmitMilliseconds;
+			double FlushMilliseconds;
+
+			// GPU time of the draws, RendererAPI::GPUTimerLatency frames old so reading it never stalls (0 if not measured)
+			double GPUMilliseconds;
+
+			// Views (BeginScene / BeginGeometry) of this frame, and the GPU time of each as GPUMilliseconds
+			uint32_t ViewCount;
+			double ViewGPUMilliseconds[RendererAPI::MaxGPUTimerViews];
+
+			bool IsGPUBound() const { return GPUMilliseconds > SubmitMilliseconds + FlushMilliseconds; }
 		};
 
 		static Statistics& GetStatistics() { return s_Statistics; }
@@ -0,0 +1,670 @@
+#include "pcheader.h"
+#include "Renderer2DCapture.h"
+
+#include <fstream>
+
+namespace OverEngine
+{
+	/////////////////////////////////////////////////////////
+	// Format ///////////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	/**
+	 * Magic and version followed by records; a CaptureRecord tag and its payload, in native byte order.
+	 * Textures and extra data are defined by their own record before the first quad using them,
+	 * textures are defined again when their sampling state changes.
+	 */
+	static constexpr char s_CaptureMagic[4] = { 'O', 'E', '2', 'C' };
+	static constexpr uint32_t s_CaptureVersion = 1;
+
+	enum class CaptureRecord : uint8_t
+	{
+		BeginScene = 1, // Mat4x4 ViewProjection
+		EndScene,
+		BeginGeometry,
+		EndGeometry,
+		DrawGeometry,   // Mat4x4 ViewProjection
+		Texture,        // uint32_t Id, TextureType, CapturedMasterTexture or CapturedSubTexture
+		ExtraData,      // uint32_t Id, CapturedExtraData
+		Quad,           // CapturedTransform, Color, float AlphaClippingThreshold
+		TexturedQuad,   // CapturedTransform, uint32_t Texture, uint32_t ExtraData, Color Tint
+		Quads,          // uint32_t Count, float AlphaClippingThreshold, QuadInstance[Count]
+		TexturedQuads   // uint32_t Count, uint32_t Texture, uint32_t ExtraData, QuadInstance[Count]
+	};
+
+	// Columns 0, 1 and 3; the Z axis of a quad transform isn't used by Renderer2D
+	struct CapturedTransform
+	{
+		Vector4 X;
+		Vector4 Y;
+		Vector4 W;
+	};
+
+	struct CapturedMasterTexture
+	{
+		uint32_t Width;
+		uint32_t Height;
+		TextureFormat Format;
+		TextureFiltering Filtering;
+		TextureWrapping XWrapping;
+		TextureWrapping YWrapping;
+		Color BorderColor;
+	};
+
+	struct CapturedSubTexture
+	{
+		uint32_t Parent;
+		glm::uvec4 Rect;
+	};
+
+	// TexturedQuadExtraData without the tint, which is stored with each quad
+	struct CapturedExtraData
+	{
+		Vector2 Tiling;
+		Vector2 Offset;
+		uint8_t FlipX;
+		uint8_t FlipY;
+		TextureWrapping XWrapping;
+		TextureWrapping YWrapping;
+		TextureFiltering Filtering;
+		uint8_t OverrideBorderColor;
+		float AlphaClipThreshold;
+		Color BorderColor;
+	};
+
+	static CapturedTransform CaptureTransform(const Mat4x4& transform)
+	{
+		return { transform[0], transform[1], transform[3] };
+	}
+
+	static Mat4x4 RestoreTransform(const CapturedTransform& captured)
+	{
+		Mat4x4 transform(1.0f);
+		transform[0] = captured.X;
+		transform[1] = captured.Y;
+		transform[3] = captured.W;
+		return transform;
+	}
+
+	/////////////////////////////////////////////////////////
+	// Recording ////////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	struct CaptureTextureState
+	{
+		std::weak_ptr<Texture2D> Texture;
+		uint32_t Id = 0;
+		uint32_t Revision = 0;
+	};
+
+	struct CaptureWriter
+	{
+		static constexpr size_t FlushSize = 1 << 20;
+
+		std::ofstream File;
+		Vector<uint8_t> Buffer;
+
+		UnorderedMap<const Texture2D*, CaptureTextureState> Textures;
+		uint32_t TextureCount = 0;
+
+		UnorderedMap<String, uint32_t> ExtraData; // Keyed by the bytes of CapturedExtraData
+
+		void Write(const void* data, size_t size)
+		{
+			Buffer.insert(Buffer.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+		}
+
+		template<typename T>
+		void Write(const T& value)
+		{
+			Write(&value, sizeof(T));
+		}
+
+		void BeginRecord(CaptureRecord record)
+		{
+			if (Buffer.size() >= FlushSize)
+				Flush();
+
+			Write(record);
+		}
+
+		void Flush()
+		{
+			File.write((const char*)Buffer.data(), Buffer.size());
+			Buffer.clear();
+		}
+	};
+
+	bool Renderer2DCapture::s_Recording = false;
+	static Scope<CaptureWriter> s_Writer;
+
+	bool Renderer2DCapture::BeginRecording(const String& filePath)
+	{
+		if (s_Recording)
+			EndRecording();
+
+		s_Writer = CreateScope<CaptureWriter>();
+		s_Writer->File.open(filePath, std::ios::binary | std::ios::trunc);
+		if (!s_Writer->File)
+		{
+			OE_CORE_ERROR("Can't create Renderer2D capture '{0}'!", filePath);
+			s_Writer.reset();
+			return false;
+		}
+
+		s_Writer->Write(s_CaptureMagic);
+		s_Writer->Write(s_CaptureVersion);
+
+		s_Recording = true;
+		return true;
+	}
+
+	void Renderer2DCapture::EndRecording()
+	{
+		if (!s_Recording)
+			return;
+
+		s_Writer->Flush();
+		s_Writer.reset();
+		s_Recording = false;
+	}
+
+	// Defines texture (and its parent) if the capture doesn't know its current state yet
+	static uint32_t WriteTexture(const Ref<Texture2D>& texture)
+	{
+		{
+			const CaptureTextureState& state = s_Writer->Textures[texture.get()];
+			if (!state.Texture.expired() && state.Revision == texture->GetRevision())
+				return state.Id;
+		}
+
+		uint32_t parent = 0;
+		if (texture->GetType() == TextureType::Subtexture)
+			parent = WriteTexture(std::get<SubTextureData>(texture->GetData()).Parent);
+
+		// Looked up again, defining the parent may have rehashed the map
+		CaptureTextureState& state = s_Writer->Textures[texture.get()];
+		if (state.Texture.expired()) // New texture or the address was reused
+		{
+			state.Texture = texture;
+			state.Id = s_Writer->TextureCount++;
+		}
+		state.Revision = texture->GetRevision();
+
+		s_Writer->BeginRecord(CaptureRecord::Texture);
+		s_Writer->Write(state.Id);
+		s_Writer->Write(texture->GetType());
+
+		if (texture->GetType() == TextureType::Subtexture)
+		{
+			CapturedSubTexture captured;
+			captured.Parent = parent;
+			captured.Rect = std::get<SubTextureData>(texture->GetData()).Rect;
+			s_Writer->Write(captured);
+		}
+		else
+		{
+			CapturedMasterTexture captured;
+			memset(&captured, 0, sizeof(captured));
+			captured.Width = texture->GetWidth();
+			captured.Height = texture->GetHeight();
+			captured.Format = texture->GetFormat();
+			captured.Filtering = texture->GetFiltering();
+			captured.XWrapping = texture->GetXWrapping();
+			captured.YWrapping = texture->GetYWrapping();
+			captured.BorderColor = texture->GetBorderColor();
+			s_Writer->Write(captured);
+		}
+
+		return state.Id;
+	}
+
+	static uint32_t WriteExtraData(const TexturedQuadExtraData& extraData)
+	{
+		// Zeroed so padding doesn't change the key
+		CapturedExtraData captured;
+		memset(&captured, 0, sizeof(captured));
+		captured.Tiling = extraData.Tiling;
+		captured.Offset = extraData.Offset;
+		captured.FlipX = extraData.Flip.x;
+		captured.FlipY = extraData.Flip.y;
+		captured.XWrapping = extraData.Wrapping.x;
+		captured.YWrapping = extraData.Wrapping.y;
+		captured.Filtering = extraData.Filtering;
+		captured.OverrideBorderColor = extraData.TextureBorderColor.first;
+		captured.AlphaClipThreshold = extraData.AlphaClipThreshold;
+		captured.BorderColor = extraData.TextureBorderColor.second;
+
+		auto result = s_Writer->ExtraData.try_emplace(String((const char*)&captured, sizeof(captured)), (uint32_t)s_Writer->ExtraData.size());
+		uint32_t id = result.first->second;
+
+		if (result.second)
+		{
+			s_Writer->BeginRecord(CaptureRecord::ExtraData);
+			s_Writer->Write(id);
+			s_Writer->Write(captured);
+		}
+
+		return id;
+	}
+
+	void Renderer2DCapture::RecordBeginScene(const Mat4x4& viewProjectionMatrix)
+	{
+		s_Writer->BeginRecord(CaptureRecord::BeginScene);
+		s_Writer->Write(viewProjectionMatrix);
+	}
+
+	void Renderer2DCapture::RecordEndScene()
+	{
+		s_Writer->BeginRecord(CaptureRecord::EndScene);
+	}
+
+	void Renderer2DCapture::RecordBeginGeometry()
+	{
+		s_Writer->BeginRecord(CaptureRecord::BeginGeometry);
+	}
+
+	void Renderer2DCapture::RecordEndGeometry()
+	{
+		s_Writer->BeginRecord(CaptureRecord::EndGeometry);
+	}
+
+	void Renderer2DCapture::RecordDrawGeometry(const Mat4x4& viewProjectionMatrix)
+	{
+		s_Writer->BeginRecord(CaptureRecord::DrawGeometry);
+		s_Writer->Write(viewProjectionMatrix);
+	}
+
+	void Renderer2DCapture::RecordQuad(const Mat4x4& transform, const Color& color, float alphaClippingThreshold)
+	{
+		s_Writer->BeginRecord(CaptureRecord::Quad);
+		s_Writer->Write(CaptureTransform(transform));
+		s_Writer->Write(color);
+		s_Writer->Write(alphaClippingThreshold);
+	}
+
+	void Renderer2DCapture::RecordQuad(const Mat4x4& transform, const Ref<Texture2D>& texture, const TexturedQuadExtraData& extraData)
+	{
+		uint32_t textureId = WriteTexture(texture);
+		uint32_t extraDataId = WriteExtraData(extraData);
+
+		s_Writer->BeginRecord(CaptureRecord::TexturedQuad);
+		s_Writer->Write(CaptureTransform(transform));
+		s_Writer->Write(textureId);
+		s_Writer->Write(extraDataId);
+		s_Writer->Write(extraData.Tint);
+	}
+
+	void Renderer2DCapture::RecordQuads(const QuadInstance* quads, uint32_t count, float alphaClippingThreshold)
+	{
+		s_Writer->BeginRecord(CaptureRecord::Quads);
+		s_Writer->Write(count);
+		s_Writer->Write(alphaClippingThreshold);
+		s_Writer->Write(quads, count * sizeof(QuadInstance));
+	}
+
+	void Renderer2DCapture::RecordQuads(const QuadInstance* quads, uint32_t count, const Ref<Texture2D>& texture, const TexturedQuadExtraData& extraData)
+	{
+		uint32_t textureId = WriteTexture(texture);
+		uint32_t extraDataId = WriteExtraData(extraData);
+
+		s_Writer->BeginRecord(CaptureRecord::TexturedQuads);
+		s_Writer->Write(count);
+		s_Writer->Write(textureId);
+		s_Writer->Write(extraDataId);
+		s_Writer->Write(quads, count * sizeof(QuadInstance));
+	}
+
+	/////////////////////////////////////////////////////////
+	// Replay ///////////////////////////////////////////////
+	/////////////////////////////////////////////////////////
+
+	struct CaptureReader
+	{
+		const uint8_t* Position;
+		const uint8_t* End;
+
+		bool Read(void* data, size_t size)
+		{
+			if ((size_t)(End - Position) < size)
+				return false;
+
+			memcpy(data, Position, size);
+			Position += size;
+			return true;
+		}
+
+		template<typename T>
+		bool Read(T& value)
+		{
+			return Read(&value, sizeof(T));
+		}
+
+		bool Skip(size_t size)
+		{
+			if ((size_t)(End - Position) < size)
+				return false;
+
+			Position += size;
+			return true;
+		}
+	};
+
+	static void ApplyTextureState(Texture2D& texture, const CapturedMasterTexture& captured)
+	{
+		// Every setter bumps the revision, which makes Renderer2D rewrite the descriptors
+		if (texture.GetFiltering() != captured.Filtering)
+			texture.SetFiltering(captured.Filtering);
+		if (texture.GetXWrapping() != captured.XWrapping)
+			texture.SetXWrapping(captured.XWrapping);
+		if (texture.GetYWrapping() != captured.YWrapping)
+			texture.SetYWrapping(captured.YWrapping);
+		if (texture.GetBorderColor() != captured.BorderColor)
+			texture.SetBorderColor(captured.BorderColor);
+	}
+
+	static TexturedQuadExtraData RestoreExtraData(const CapturedExtraData& captured)
+	{
+		TexturedQuadExtraData extraData;
+		extraData.Tiling = captured.Tiling;
+		extraData.Offset = captured.Offset;
+		extraData.Flip = { captured.FlipX != 0, captured.FlipY != 0 };
+		extraData.Wrapping = { captured.XWrapping, captured.YWrapping };
+		extraData.Filtering = captured.Filtering;
+		extraData.AlphaClipThreshold = captured.AlphaClipThreshold;
+		extraData.TextureBorderColor = { captured.OverrideBorderColor != 0, captured.BorderColor };
+		return extraData;
+	}
+
+	bool Renderer2DReplay::Load(const String& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			OE_CORE_ERROR("Can't open Renderer2D capture '{0}'!", filePath);
+			return false;
+		}
+
+		m_Data.resize((size_t)file.tellg());
+		file.seekg(0);
+		file.read((char*)m_Data.data(), m_Data.size());
+
+		m_FrameOffsets.clear();
+		m_Textures.clear();
+		m_ExtraData.clear();
+		m_QuadCount = 0;
+		m_CameraCount = 0;
+
+		if (!Parse())
+		{
+			OE_CORE_ERROR("'{0}' is not a valid Renderer2D capture!", filePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Validates the records, splits them into frames and creates the textures and extra data
+	bool Renderer2DReplay::Parse()
+	{
+		CaptureReader reader{ m_Data.data(), m_Data.data() + m_Data.size() };
+
+		char magic[4];
+		uint32_t version;
+		if (!reader.Read(magic) || memcmp(magic, s_CaptureMagic, sizeof(magic)) != 0)
+			return false;
+		if (!reader.Read(version) || version != s_CaptureVersion)
+			return false;
+
+		auto isTexture = [this](uint32_t id) { return id < m_Textures.size() && m_Textures[id]; };
+		auto isExtraData = [this](uint32_t id) { return id < m_ExtraData.size(); };
+
+		while (reader.Position != reader.End)
+		{
+			size_t offset = reader.Position - m_Data.data();
+
+			CaptureRecord record;
+			reader.Read(record);
+
+			switch (record)
+			{
+			case CaptureRecord::BeginScene:
+			case CaptureRecord::DrawGeometry:
+				if (record == CaptureRecord::BeginScene)
+					m_FrameOffsets.push_back(offset);
+
+				m_CameraCount++;
+				if (!reader.Skip(sizeof(Mat4x4)))
+					return false;
+				break;
+
+			case CaptureRecord::BeginGeometry:
+				m_FrameOffsets.push_back(offset);
+				break;
+
+			case CaptureRecord::EndScene:
+			case CaptureRecord::EndGeometry:
+				break;
+
+			case CaptureRecord::Texture:
+			{
+				uint32_t id;
+				TextureType type;
+				if (!reader.Read(id) || !reader.Read(type))
+					return false;
+
+				if (id >= m_Textures.size())
+					m_Textures.resize(id + 1);
+
+				if (type == TextureType::Subtexture)
+				{
+					CapturedSubTexture captured;
+					if (!reader.Read(captured) || !isTexture(captured.Parent))
+						return false;
+
+					if (!m_Textures[id])
+						m_Textures[id] = Texture2D::CreateSubTexture(m_Textures[captured.Parent], Rect(captured.Rect));
+				}
+				else
+				{
+					CapturedMasterTexture captured;
+					if (!reader.Read(captured) || (captured.Format != TextureFormat::RGB && captured.Format != TextureFormat::RGBA))
+						return false;
+
+					// Later definitions only change the sampling state, applied when the frame is replayed
+					if (!m_Textures[id])
+					{
+						m_Textures[id] = Texture2D::CreateMaster(captured.Width, captured.Height, captured.Format);
+						ApplyTextureState(*m_Textures[id], captured);
+					}
+				}
+				break;
+			}
+
+			case CaptureRecord::ExtraData:
+			{
+				uint32_t id;
+				CapturedExtraData captured;
+				if (!reader.Read(id) || !reader.Read(captured) || id != m_ExtraData.size())
+					return false;
+
+				m_ExtraData.push_back(RestoreExtraData(captured));
+				break;
+			}
+
+			case CaptureRecord::Quad:
+				m_QuadCount++;
+				if (!reader.Skip(sizeof(CapturedTransform) + sizeof(Color) + sizeof(float)))
+					return false;
+				break;
+
+			case CaptureRecord::TexturedQuad:
+			{
+				CapturedTransform transform;
+				uint32_t texture, extraData;
+				Color tint;
+				if (!reader.Read(transform) || !reader.Read(texture) || !reader.Read(extraData) || !reader.Read(tint))
+					return false;
+				if (!isTexture(texture) || !isExtraData(extraData))
+					return false;
+
+				m_QuadCount++;
+				break;
+			}
+
+			case CaptureRecord::Quads:
+			{
+				uint32_t count;
+				float alphaClippingThreshold;
+				if (!reader.Read(count) || !reader.Read(alphaClippingThreshold) || !reader.Skip((size_t)count * sizeof(QuadInstance)))
+					return false;
+
+				m_QuadCount += count;
+				break;
+			}
+
+			case CaptureRecord::TexturedQuads:
+			{
+				uint32_t count, texture, extraData;
+				if (!reader.Read(count) || !reader.Read(texture) || !reader.Read(extraData) || !reader.Skip((size_t)count * sizeof(QuadInstance)))
+					return false;
+				if (!isTexture(texture) || !isExtraData(extraData))
+					return false;
+
+				m_QuadCount += count;
+				break;
+			}
+
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Renderer2DReplay::ReplayFrame(uint32_t frame)
+	{
+		OE_CORE_ASSERT(frame < GetFrameCount(), "Frame {0} is out of range!", frame);
+
+		size_t end = frame + 1 < GetFrameCount() ? m_FrameOffsets[frame + 1] : m_Data.size();
+		CaptureReader reader{ m_Data.data() + m_FrameOffsets[frame], m_Data.data() + end };
+
+		// Parse validated the records, reads can't fail
+		Vector<QuadInstance> quads;
+
+		while (reader.Position != reader.End)
+		{
+			CaptureRecord record;
+			reader.Read(record);
+
+			switch (record)
+			{
+			case CaptureRecord::BeginScene:
+			{
+				Mat4x4 viewProjection;
+				reader.Read(viewProjection);
+				Renderer2D::BeginScene(viewProjection);
+				break;
+			}
+
+			case CaptureRecord::EndScene:
+				Renderer2D::EndScene();
+				break;
+
+			case CaptureRecord::BeginGeometry:
+				Renderer2D::BeginGeometry();
+				break;
+
+			case CaptureRecord::EndGeometry:
+				Renderer2D::EndGeometry();
+				break;
+
+			case CaptureRecord::DrawGeometry:
+			{
+				Mat4x4 viewProjection;
+				reader.Read(viewProjection);
+				Renderer2D::DrawGeometry(viewProjection);
+				break;
+			}
+
+			case CaptureRecord::Texture:
+			{
+				uint32_t id;
+				TextureType type;
+				reader.Read(id);
+				reader.Read(type);
+
+				if (type == TextureType::Subtexture)
+				{
+					reader.Skip(sizeof(CapturedSubTexture));
+				}
+				else
+				{
+					CapturedMasterTexture captured;
+					reader.Read(captured);
+					ApplyTextureState(*m_Textures[id], captured);
+				}
+				break;
+			}
+
+			case CaptureRecord::ExtraData:
+				reader.Skip(sizeof(uint32_t) + sizeof(CapturedExtraData));
+				break;
+
+			case CaptureRecord::Quad:
+			{
+				CapturedTransform transform;
+				Color color;
+				float alphaClippingThreshold;
+				reader.Read(transform);
+				reader.Read(color);
+				reader.Read(alphaClippingThreshold);
+				Renderer2D::DrawQuad(RestoreTransform(transform), color, alphaClippingThreshold);
+				break;
+			}
+
+			case CaptureRecord::TexturedQuad:
+			{
+				CapturedTransform transform;
+				uint32_t texture, extraData;
+				reader.Read(transform);
+				reader.Read(texture);
+				reader.Read(extraData);
+
+				TexturedQuadExtraData quadExtraData = m_ExtraData[extraData];
+				reader.Read(quadExtraData.Tint);
+				Renderer2D::DrawQuad(RestoreTransform(transform), m_Textures[texture], quadExtraData);
+				break;
+			}
+
+			case CaptureRecord::Quads:
+			{
+				uint32_t count;
+				float alphaClippingThreshold;
+				reader.Read(count);
+				reader.Read(alphaClippingThreshold);
+
+				// Copied out, records aren't aligned
+				quads.resize(count);
+				reader.Read(quads.data(), count * sizeof(QuadInstance));
+				Renderer2D::DrawQuads(quads.data(), count, alphaClippingThreshold);
+				break;
+			}
+
+			case CaptureRecord::TexturedQuads:
+			{
+				uint32_t count, texture, extraData;
+				reader.Read(count);
+				reader.Read(texture);
+				reader.Read(extraData);
+
+				quads.resize(count);
+				reader.Read(quads.data(), count * sizeof(QuadInstance));
+				Renderer2D::DrawQuads(quads.data(), count, m_Textures[texture], m_ExtraData[extraData]);
+				break;
+			}
+			}
+		}
+	}
+}
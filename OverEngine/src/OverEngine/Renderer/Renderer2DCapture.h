@@ -0,0 +1,71 @@
+#pragma once
+
+#include "OverEngine/Renderer/Renderer2D.h"
+
+namespace OverEngine
+{
+	/**
+	 * Records the Renderer2D calls (scenes, geometry, quads and the textures they use) into a binary capture file.
+	 * Textures are recorded by identity, size, format and sampling state; not by pixels.
+	 * Retained batches are recorded as the quads of their visible slots each time they're drawn,
+	 * so they replay as immediate quads.
+	 */
+	class Renderer2DCapture
+	{
+	public:
+		// Returns false if filePath can't be created
+		static bool BeginRecording(const String& filePath);
+		static void EndRecording();
+		inline static bool IsRecording() { return s_Recording; }
+
+		// Called by Renderer2D while recording
+		static void RecordBeginScene(const Mat4x4& viewProjectionMatrix);
+		static void RecordEndScene();
+		static void RecordBeginGeometry();
+		static void RecordEndGeometry();
+		static void RecordDrawGeometry(const Mat4x4& viewProjectionMatrix);
+
+		static void RecordQuad(const Mat4x4& transform, const Color& color, float alphaClippingThreshold);
+		static void RecordQuad(const Mat4x4& transform, const Ref<Texture2D>& texture, const TexturedQuadExtraData& extraData);
+		static void RecordQuads(const QuadInstance* quads, uint32_t count, float alphaClippingThreshold);
+		static void RecordQuads(const QuadInstance* quads, uint32_t count, const Ref<Texture2D>& texture, const TexturedQuadExtraData& extraData);
+	private:
+		static bool s_Recording;
+	};
+
+	/**
+	 * A capture loaded to memory, replayed through Renderer2D one frame at a time.
+	 * Textures are recreated as blank textures with the recorded size, format and sampling state,
+	 * so atlas packing, batching and uploads follow the recorded session.
+	 */
+	class Renderer2DReplay
+	{
+	public:
+		// Returns false if filePath isn't a valid capture
+		bool Load(const String& filePath);
+
+		// A frame starts at each BeginScene / BeginGeometry
+		inline uint32_t GetFrameCount() const { return (uint32_t)m_FrameOffsets.size(); }
+
+		// Totals over all frames
+		inline uint64_t GetQuadCount() const { return m_QuadCount; }
+		inline uint64_t GetCameraCount() const { return m_CameraCount; }
+
+		inline const Vector<Ref<Texture2D>>& GetTextures() const { return m_Textures; }
+
+		// Issues the recorded calls of frame
+		void ReplayFrame(uint32_t frame);
+	private:
+		bool Parse();
+	private:
+		Vector<uint8_t> m_Data;
+		Vector<size_t> m_FrameOffsets;
+
+		// Indexed by the ids of the capture
+		Vector<Ref<Texture2D>> m_Textures;
+		Vector<TexturedQuadExtraData> m_ExtraData;
+
+		uint64_t m_QuadCount = 0;
+		uint64_t m_CameraCount = 0;
+	};
+}
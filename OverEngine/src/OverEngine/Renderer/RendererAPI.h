@@ -5,14 +5,26 @@
 
 namespace OverEngine
 {
+	enum class BlendMode
+	{
+		None = 0,
+		Alpha,   // SrcAlpha, OneMinusSrcAlpha
+		Additive // One, One
+	};
+
 	class RendererAPI
 	{
 	public:
 		enum class API
 		{
-			None = 0, OpenGL = 1
+			None = 0, OpenGL = 1,
+
+			// Headless, accepts and counts every call without touching a GPU (see NullRecorder)
+			Null = 2
 		};
 	public:
+		virtual ~RendererAPI() = default;
+
 		virtual void Init() = 0;
 
 		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
@@ -20,12 +32,41 @@ namespace OverEngine
 		virtual void SetClearDepth(float depth) = 0;
 		virtual void Clear(const ClearFlags& flags) = 0;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
+
+		// Counts the samples passing the depth test between the two calls, EndSampleCount waits for the GPU
+		virtual void BeginSampleCount() = 0;
+		virtual uint64_t EndSampleCount() = 0;
+
+		/**
+		 * Measures the GPU time of the commands between BeginGPUTimer and EndGPUTimer, each pair with its own query.
+		 * NextGPUTimerFrame is called once per frame, results are read GPUTimerLatency frames later so the CPU never
+		 * waits for the GPU. GetGPUFrameTime returns the latest finished frame in nanoseconds, GetGPUViewTime only
+		 * the pairs begun for view (views past MaxGPUTimerViews share the last one), 0 if timers aren't supported.
+		 */
+		static constexpr uint32_t GPUTimerLatency = 4;
+		static constexpr uint32_t MaxGPUTimerViews = 8;
+
+		virtual void NextGPUTimerFrame() = 0;
+		virtual void BeginGPUTimer(uint32_t view) = 0;
+		virtual void EndGPUTimer() = 0;
+		virtual uint64_t GetGPUFrameTime() = 0;
+		virtual uint64_t GetGPUViewTime(uint32_t view) = 0;
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) = 0;
+		virtual void DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance = 0) = 0;
 
 		virtual uint32_t GetMaxTextureSize() = 0;
 		virtual uint32_t GetMaxTextureSlotCount() = 0;
+		virtual uint32_t GetMaxArrayTextureLayers() = 0; // 0 if texture arrays are not supported
+
+		// State changes skipped during the last frame because they wouldn't change anything
+		virtual uint32_t GetElidedCallCount() = 0;
 
 		inline static API GetAPI() { return s_API; }
+
+		// Must be called before the main window is created
+		inline static void SetAPI(API api) { s_API = api; }
 	private:
 		static API s_API;
 	};
@@ -5,6 +5,7 @@
 
 #include "OverEngine/Core/Window.h"
 #include "Platform/OpenGL/OpenGLContext.h"
+#include "Platform/Null/NullContext.h"
 
 namespace OverEngine
 {
@@ -14,6 +15,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateScope<OpenGLContext>(window);
+		case RendererAPI::API::Null:    return CreateScope<NullContext>(window);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -6,6 +6,7 @@
 #include "RendererAPI.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Platform/OpenGL/OpenGLIntermediateShader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace OverEngine
 {
@@ -13,12 +14,13 @@ namespace OverEngine
 	// Shader ///////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
 
-	Ref<Shader> Shader::Create(const String& filePath)
+	Ref<Shader> Shader::Create(const String& filePath, const Vector<String>& defines /*= {}*/)
 	{
 		switch (RendererAPI::GetAPI())
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filePath);
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filePath, defines);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(String(), filePath);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -31,6 +33,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(name);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -43,6 +46,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(name);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -55,6 +59,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexShader, fragmentShader);
+		case RendererAPI::API::Null:    return CreateRef<NullShader>(name);
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -71,6 +76,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return new OpenGLIntermediateShader(Source, type);
+		case RendererAPI::API::Null:    return new NullIntermediateShader();
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -118,4 +124,20 @@ namespace OverEngine
 		return m_Shaders.find(name) != m_Shaders.end();
 	}
 
+	Ref<Shader> ShaderLibrary::LoadPermutation(const String& filePath, const Vector<String>& defines)
+	{
+		// Same set in another order is the same permutation
+		Vector<String> sortedDefines = defines;
+		std::sort(sortedDefines.begin(), sortedDefines.end());
+
+		String key = filePath;
+		for (const auto& define : sortedDefines)
+			key += '|' + define;
+
+		auto& shader = m_Permutations[key];
+		if (!shader)
+			shader = Shader::Create(filePath, sortedDefines);
+		return shader;
+	}
+
 }
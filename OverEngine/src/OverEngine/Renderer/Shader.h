@@ -31,7 +31,8 @@ namespace OverEngine
 		virtual bool Reload(const String& vertexSrc, const String& fragmentSrc) = 0;
 		virtual bool Reload(const char* vertexSrc, const char* fragmentSrc) = 0;
 
-		static Ref<Shader> Create(const String& filePath);
+		// defines are inserted as '#define X' lines after the #version of every stage
+		static Ref<Shader> Create(const String& filePath, const Vector<String>& defines = {});
 		static Ref<Shader> Create(const String& name, const String& vertexSrc, const String& fragmentSrc);
 		static Ref<Shader> Create(const String& name, const char* vertexSrc, const char* fragmentSrc);
 		static Ref<Shader> Create(const String& name, Ref<IntermediateShader>& vertexShader, const Ref<IntermediateShader>& fragmentShader);
@@ -58,7 +59,11 @@ namespace OverEngine
 		Ref<Shader> Get(const String& name);
 
 		bool Exists(const String& name) const;
+
+		// The shader at filePath compiled with defines, compiled on first use and cached after
+		Ref<Shader> LoadPermutation(const String& filePath, const Vector<String>& defines);
 	private:
 		UnorderedMap<String, Ref<Shader>> m_Shaders;
+		UnorderedMap<String, Ref<Shader>> m_Permutations; // Keyed by file path and sorted defines
 	};
 }
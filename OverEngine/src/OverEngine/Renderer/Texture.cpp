@@ -3,6 +3,7 @@
 #include "OverEngine/Assets/Texture2DAsset.h"
 
 #include "OverEngine/Renderer/TextureManager.h"
+#include "OverEngine/Renderer/CookedTexture.h"
 #include <stb_image.h>
 
 namespace OverEngine
@@ -14,6 +15,27 @@ namespace OverEngine
 		return texture;
 	}
 
+	Ref<Texture2D> Texture2D::CreateMaster(uint32_t width, uint32_t height, TextureFormat format)
+	{
+		Ref<Texture2D> texture = CreateRef<Texture2D>(width, height, format);
+		TextureManager::AddTexture(texture);
+		return texture;
+	}
+
+	Ref<Texture2D> Texture2D::CreateMaster(const Ref<CookedTexture>& cooked, const String& sourcePath)
+	{
+		Ref<Texture2D> texture = CreateRef<Texture2D>(cooked, sourcePath);
+		TextureManager::AddTexture(texture);
+		return texture;
+	}
+
+	Ref<Texture2D> Texture2D::CreateMasterAsync(const String& path)
+	{
+		Ref<Texture2D> texture = CreatePlaceholder(0, 0);
+		TextureManager::LoadAsync(texture, path);
+		return texture;
+	}
+
 	Ref<Texture2D> Texture2D::CreateSubTexture(Ref<Texture2D> masterTexture, Rect rect)
 	{
 		if (masterTexture->GetType() == TextureType::Subtexture)
@@ -22,6 +44,12 @@ namespace OverEngine
 			return nullptr;
 		}
 
+		if (masterTexture->GetType() == TextureType::Placeholder)
+		{
+			OE_CORE_ERROR("Cannot create a subtexture from a placeholder!");
+			return nullptr;
+		}
+
 		return CreateRef<Texture2D>(masterTexture, rect);
 	}
 
@@ -55,6 +83,38 @@ namespace OverEngine
 		__Texture2D_GetMasterTextureData.Format = format;
 		__Texture2D_GetMasterTextureData.Filtering = TextureFiltering::Linear;
 		__Texture2D_GetMasterTextureData.Pixels = data;
+		__Texture2D_GetMasterTextureData.SourcePath = path;
+	}
+
+	Texture2D::Texture2D(uint32_t width, uint32_t height, TextureFormat format)
+		: m_Type(TextureType::Master), m_Data(MasterTextureData())
+	{
+		OE_CORE_ASSERT(format == TextureFormat::RGB || format == TextureFormat::RGBA, "Unsupported image format");
+
+		size_t size = (size_t)width * height * (format == TextureFormat::RGBA ? 4 : 3);
+
+		// Released with stbi_image_free like loaded pixels
+		uint8_t* pixels = (uint8_t*)malloc(size);
+		memset(pixels, 0xFF, size);
+
+		__Texture2D_GetMasterTextureData.Width = width;
+		__Texture2D_GetMasterTextureData.Height = height;
+		__Texture2D_GetMasterTextureData.Format = format;
+		__Texture2D_GetMasterTextureData.Filtering = TextureFiltering::Linear;
+		__Texture2D_GetMasterTextureData.Pixels = pixels;
+	}
+
+	Texture2D::Texture2D(const Ref<CookedTexture>& cooked, const String& sourcePath)
+		: m_Type(TextureType::Master), m_Data(MasterTextureData())
+	{
+		// Nothing is decoded, pixels are only copied out of the mapping if an atlas can't take the cooked levels
+		__Texture2D_GetMasterTextureData.Width = cooked->GetHeader().Width;
+		__Texture2D_GetMasterTextureData.Height = cooked->GetHeader().Height;
+		__Texture2D_GetMasterTextureData.Format = cooked->GetSourceFormat();
+		__Texture2D_GetMasterTextureData.Filtering = TextureFiltering::Linear;
+		__Texture2D_GetMasterTextureData.Pixels = nullptr;
+		__Texture2D_GetMasterTextureData.SourcePath = sourcePath;
+		__Texture2D_GetMasterTextureData.Cooked = cooked;
 	}
 
 	Texture2D::Texture2D(Ref<Texture2D> masterTexture, Rect rect)
@@ -70,19 +130,56 @@ namespace OverEngine
 	Texture2D::~Texture2D()
 	{
 		if (m_Type == TextureType::Master)
+		{
+			// Atlases only keep raw pointers to their members
+			if (__Texture2D_GetMasterTextureData.Managed)
+				TextureManager::RemoveTexture(this);
+
 			stbi_image_free(__Texture2D_GetMasterTextureData.Pixels);
+		}
+	}
+
+	bool Texture2D::ReloadPixels()
+	{
+		if (m_Type != TextureType::Master)
+			return false;
+
+		auto& data = __Texture2D_GetMasterTextureData;
+		if (data.Pixels)
+			return true;
+
+		// Released with stbi_image_free like loaded pixels
+		if (data.Cooked)
+		{
+			data.Pixels = (uint8_t*)malloc((size_t)data.Width * data.Height * (data.Format == TextureFormat::RGBA ? 4 : 3));
+			data.Cooked->CopySourcePixels(data.Pixels, data.Format);
+			return true;
+		}
+
+		if (data.SourcePath.empty())
+			return false;
+
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(0);
+		stbi_uc* pixels = stbi_load(data.SourcePath.c_str(), &width, &height, &channels, data.Format == TextureFormat::RGBA ? 4 : 3);
+
+		// A changed file doesn't fit the atlas rect anymore
+		if (!pixels || (uint32_t)width != data.Width || (uint32_t)height != data.Height)
+		{
+			OE_CORE_ERROR("Failed to reload image '{0}'!", data.SourcePath);
+			stbi_image_free(pixels);
+			return false;
+		}
+
+		data.Pixels = pixels;
+		return true;
 	}
 
 	const String& Texture2D::GetName() const
 	{
 		static String placeholder = "Placeholder Texture";
 
-		Texture2DAsset* asset = nullptr;
-		if (m_Type == TextureType::Master)
-			asset = __Texture2D_GetMasterTextureData.Asset;
-		else if (m_Type == TextureType::Subtexture)
-			asset = __Texture2D_GetParentMasterTextureData.Asset;
-
+		Texture2DAsset* asset = GetAsset();
 		if (asset)
 			return asset->GetName();
 		else if (m_Type == TextureType::Placeholder)
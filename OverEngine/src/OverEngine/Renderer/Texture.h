@@ -36,6 +36,7 @@ namespace OverEngine
 	};
 
 	class Texture2DAsset;
+	class CookedTexture;
 
 	struct MasterTextureData
 	{
@@ -48,12 +49,20 @@ namespace OverEngine
 		Vec2T<TextureWrapping> Wrapping = { TextureWrapping::Repeat, TextureWrapping::Repeat };
 		Color BorderColor = { 0.0f, 0.0f, 0.0f, 1.0f };
 
-		uint8_t* Pixels;
+		uint8_t* Pixels; // nullptr once released by TextureManager, see SetReleasePixels
+		String SourcePath; // File Pixels can be read again from, empty for textures made in memory
+		Ref<CookedTexture> Cooked; // Mapped .oetex, uploaded from instead of Pixels when it fits the atlas layout
 
-		Ref<GAPI::Texture2D> MappedTexture;
+		Ref<GAPI::Texture2D> MappedTexture; // nullptr while evicted from the atlases
 		Rect MappedTextureRect;
 
+		bool Managed = false; // Added to TextureManager
+		uint64_t LastUsedFrame = 0; // TextureManager frame it was last drawn in
+
 		Texture2DAsset* Asset = nullptr;
+
+		// Bumped whenever sampling state or atlas mapping changes
+		uint32_t Revision = 0;
 	};
 
 	class Texture2D;
@@ -68,6 +77,8 @@ namespace OverEngine
 	{
 		uint64_t AssetGuid;
 		uint64_t Texture2DGuid;
+
+		Texture2DAsset* Asset = nullptr; // Passed on to the master texture once loaded
 	};
 
 	class TextureManager;
@@ -84,7 +95,10 @@ namespace OverEngine
 	
 	#define __Texture2D_COMMON_ASSERT(what_to_set, set_to_what, msg)             \
 		if (m_Type == TextureType::Master)                                       \
+		{                                                                        \
 			__Texture2D_GetMasterTextureData.what_to_set = set_to_what;          \
+			__Texture2D_GetMasterTextureData.Revision++;                         \
+		}                                                                        \
 		else                                                                     \
 			OE_CORE_ERROR("Cannot set Subtexture's and Placeholder's " msg "!");
 
@@ -95,10 +109,17 @@ namespace OverEngine
 
 	public:
 		static Ref<Texture2D> CreateMaster(const String& path);
+		static Ref<Texture2D> CreateMaster(uint32_t width, uint32_t height, TextureFormat format); // Opaque white pixels
+		static Ref<Texture2D> CreateMaster(const Ref<CookedTexture>& cooked, const String& sourcePath); // See TextureCooker
+
+		// Returns a Placeholder which becomes the master texture once decoded and uploaded, see TextureManager::LoadAsync
+		static Ref<Texture2D> CreateMasterAsync(const String& path);
 		static Ref<Texture2D> CreateSubTexture(Ref<Texture2D> masterTexture, Rect rect);
 		static Ref<Texture2D> CreatePlaceholder(const uint64_t& assetGuid, const uint64_t& textureGuid);
 
 		Texture2D(const String& path); // CreateMaster
+		Texture2D(uint32_t width, uint32_t height, TextureFormat format); // CreateMaster
+		Texture2D(const Ref<CookedTexture>& cooked, const String& sourcePath); // CreateMaster
 		Texture2D(Ref<Texture2D> masterTexture, Rect rect); // CreateSubTexture
 		Texture2D(const uint64_t& assetGuid, const uint64_t& textureGuid); // CreatePlaceholder
 		virtual ~Texture2D();
@@ -135,7 +156,20 @@ namespace OverEngine
 			return nullptr;
 		}
 
-		Texture2DAsset* GetAsset() const { __Texture2D_COMMON_GET(Asset, nullptr); }
+		// Released pixels are copied again from the cooked file or read from SourcePath, false if there is none or reading failed
+		bool ReloadPixels();
+
+		Texture2DAsset* GetAsset() const
+		{
+			// Asset textures loading asynchronously
+			if (m_Type == TextureType::Placeholder)
+				return std::get<PlaceHolderTextureData>(m_Data).Asset;
+
+			__Texture2D_COMMON_GET(Asset, nullptr);
+		}
+
+		// Changes when anything the renderer caches about this texture (sampling state, atlas rect) changes
+		inline uint32_t GetRevision() const { __Texture2D_COMMON_GET(Revision, 0); }
 		const auto& GetData() const { return m_Data; }
 	private:
 		TextureType m_Type;
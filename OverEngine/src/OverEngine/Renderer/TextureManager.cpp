@@ -3,32 +3,526 @@
 
 #include "OverEngine/Renderer/GAPI/GTexture.h"
 #include "OverEngine/Renderer/RenderCommand.h"
+#include "OverEngine/Renderer/AtlasPacker.h"
+#include "OverEngine/Renderer/Buffer.h"
+#include "OverEngine/Renderer/CookedTexture.h"
+#include "OverEngine/Core/Time/Time.h"
+#include "OverEngine/Core/ThreadPool.h"
 
-#include <stb_rectpack.h>
+#include <stb_image.h>
+#include <atomic>
+#include <deque>
 
 namespace OverEngine
 {
+	struct DecodedImage
+	{
+		std::weak_ptr<Texture2D> Texture; // Placeholder to turn into the master texture
+		String Path;
+		uint8_t* Pixels;
+		uint32_t Width, Height;
+		TextureFormat Format;
+	};
+
 	struct TextureManagerData
 	{
-		Vector<Ref<Texture2D>> MasterTextures;
+		static constexpr uint32_t InitialPageCount = 4; // Layers allocated with the page array
+
+		// Atlases at most this full whose scattered free space reaches the ratio are evacuated
+		static constexpr float DefragMaxOccupancy = 0.5f;
+		static constexpr float DefragMinWastedSpaceRatio = 0.25f;
+		static constexpr uint64_t DefragRetryFrames = 120; // Wait after finding nothing to move
+
+		Vector<Texture2D*> MasterTextures; // Not owned, textures remove themselves when destroyed
 
-		Vector<stbrp_node> NodeCache;
-		Vector<stbrp_rect> RectCache;
+		Vector<unsigned char> ExtrudeCache;
 
+		// Atlases written since their mip levels were last generated, see GenerateDirtyMipmaps
+		Vector<Ref<GAPI::Texture2D>> MipmapsDirty;
+
+		// Parallel arrays, one entry per atlas (standalone or page)
 		Vector<Ref<GAPI::Texture2D>> GPUTextures;
-		Vector<stbrp_context> RectanglePackers;
+		Vector<uint32_t> GPUTextureGutters;
+		Vector<AtlasPacker> Packers; // Free space of the atlas, placed rects never move
+
+		Ref<GAPI::Texture2DArray> Pages;
+		uint32_t PageCount = 0; // Layers of Pages in use, the rest is spare capacity
+		uint32_t PageSize = 2048; // Power of two, also the size of standalone atlases
+		uint32_t PageGutter = 0; // Mip count is fixed with the storage, so is the gutter of every page
+		bool Paged = false;
+
+		uint32_t Gutter = 2;
+		bool MipmapsEnabled = true;
+		bool ReleasePixels = false;
+
+		uint64_t Frame = 1;
+		uint32_t MappingEpoch = 0;
+		uint64_t MemoryBudget = 0;
+
+		bool Defragmentation = true;
+		float DefragMilliseconds = 0.5f;
+		uint64_t DefragIdleUntilFrame = 0;
+
+		// Async loading, decoders push to Decoded, Update moves them to PendingUploads
+		std::mutex DecodedMutex;
+		Vector<DecodedImage> Decoded;
+		std::deque<DecodedImage> PendingUploads;
+		std::atomic<uint32_t> PendingLoadCount = 0;
+		uint32_t LoadEpoch = 0;
+
+		Scope<ThreadPool> Decoders; // Created with the first async load
+		Ref<PixelUnpackBuffer> UploadBuffer; // One region per frame, UploadBudget bytes each
+		uint32_t UploadBudget = 4 * 1024 * 1024;
+		bool Staging = false; // UploadExtruded writes to UploadBuffer
 	};
 
-	static TextureManagerData* s_ManagerData;
+	static TextureManagerData* s_ManagerData = nullptr;
 
 	void TextureManager::Init()
 	{
 		s_ManagerData = new TextureManagerData();
+		SetPaged(true);
 	}
 
 	void TextureManager::Shutdown()
 	{
+		// Decoders may still push their images
+		s_ManagerData->Decoders.reset();
+
+		for (auto& image : s_ManagerData->Decoded)
+			stbi_image_free(image.Pixels);
+		for (auto& image : s_ManagerData->PendingUploads)
+			stbi_image_free(image.Pixels);
+
 		delete s_ManagerData;
+
+		// Textures outliving the renderer skip RemoveTexture
+		s_ManagerData = nullptr;
+	}
+
+	void TextureManager::SetGutter(uint32_t gutter) { s_ManagerData->Gutter = gutter; }
+	uint32_t TextureManager::GetGutter() { return s_ManagerData->Gutter; }
+
+	void TextureManager::SetMipmapsEnabled(bool enabled) { s_ManagerData->MipmapsEnabled = enabled; }
+	bool TextureManager::IsMipmapsEnabled() { return s_ManagerData->MipmapsEnabled; }
+
+	// Only textures which can read them again from their file, cooked ones always as the mapping stays open
+	void TextureManager::ReleaseTexturePixels(Texture2D* texture)
+	{
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		if (!data.Cooked && (!s_ManagerData->ReleasePixels || data.SourcePath.empty()))
+			return;
+
+		stbi_image_free(data.Pixels);
+		data.Pixels = nullptr;
+	}
+
+	void TextureManager::SetReleasePixels(bool release)
+	{
+		s_ManagerData->ReleasePixels = release;
+
+		for (Texture2D* texture : s_ManagerData->MasterTextures)
+		{
+			if (std::get<MasterTextureData>(texture->m_Data).MappedTexture)
+				ReleaseTexturePixels(texture);
+		}
+	}
+
+	bool TextureManager::IsReleasingPixels() { return s_ManagerData->ReleasePixels; }
+
+	void TextureManager::SetPaged(bool paged, uint32_t pageSize /*= 2048*/)
+	{
+		if (paged && RenderCommand::GetMaxArrayTextureLayers() == 0)
+		{
+			OE_CORE_WARN("Texture arrays are not supported, TextureManager falls back to standalone atlases");
+			paged = false;
+		}
+
+		s_ManagerData->Paged = paged;
+
+		// Existing pages keep their size
+		if (!s_ManagerData->Pages)
+		{
+			pageSize = std::min(pageSize, RenderCommand::GetMaxTextureSize());
+
+			// Round down to a power of two
+			uint32_t powerOfTwo = 1;
+			while (powerOfTwo <= pageSize / 2)
+				powerOfTwo *= 2;
+			s_ManagerData->PageSize = powerOfTwo;
+		}
+	}
+
+	bool TextureManager::IsPaged() { return s_ManagerData->Paged; }
+	const Ref<GAPI::Texture2DArray>& TextureManager::GetPages() { return s_ManagerData->Pages; }
+
+	uint64_t TextureManager::GetFrame() { return s_ManagerData->Frame; }
+	uint32_t TextureManager::GetMappingEpoch() { return s_ManagerData->MappingEpoch; }
+
+	void TextureManager::SetMemoryBudget(uint64_t bytes) { s_ManagerData->MemoryBudget = bytes; }
+	uint64_t TextureManager::GetMemoryBudget() { return s_ManagerData->MemoryBudget; }
+
+	void TextureManager::SetDefragmentation(bool enabled, float millisecondsPerFrame /*= 0.5f*/)
+	{
+		s_ManagerData->Defragmentation = enabled;
+		s_ManagerData->DefragMilliseconds = millisecondsPerFrame;
+		s_ManagerData->DefragIdleUntilFrame = 0;
+	}
+
+	bool TextureManager::IsDefragmentationEnabled() { return s_ManagerData->Defragmentation; }
+
+	// Index of atlas in the parallel arrays, GPUTextures.size() if it isn't ours
+	static uint32_t FindGPUTexture(const GAPI::Texture2D* atlas)
+	{
+		uint32_t tID = 0;
+		while (tID < s_ManagerData->GPUTextures.size() && s_ManagerData->GPUTextures[tID].get() != atlas)
+			tID++;
+		return tID;
+	}
+
+	uint32_t TextureManager::GetAtlasGutter(const Ref<GAPI::Texture2D>& atlas)
+	{
+		uint32_t tID = FindGPUTexture(atlas.get());
+		return tID < s_ManagerData->GPUTextureGutters.size() ? s_ManagerData->GPUTextureGutters[tID] : 0;
+	}
+
+	// RGBA storage of all mip levels
+	static uint64_t GetStorageBytes(uint32_t width, uint32_t height, uint32_t mipLevels)
+	{
+		uint64_t bytes = 0;
+		for (uint32_t level = 0; level < mipLevels; level++)
+			bytes += (uint64_t)std::max(width >> level, 1u) * std::max(height >> level, 1u) * 4;
+		return bytes;
+	}
+
+	uint64_t TextureManager::GetAllocatedBytes()
+	{
+		uint64_t bytes = 0;
+
+		for (const auto& gpuTexture : s_ManagerData->GPUTextures)
+		{
+			if (gpuTexture->GetArrayLayer() == -1)
+				bytes += GetStorageBytes(gpuTexture->GetWidth(), gpuTexture->GetHeight(), gpuTexture->GetMipLevelCount());
+		}
+
+		// Spare layers are allocated too
+		if (const auto& pages = s_ManagerData->Pages)
+			bytes += GetStorageBytes(pages->GetWidth(), pages->GetHeight(), pages->GetMipLevelCount()) * pages->GetLayerCount();
+
+		return bytes;
+	}
+
+	static float GetWastedSpaceRatio(const AtlasPacker& packer)
+	{
+		uint64_t area = (uint64_t)packer.GetWidth() * packer.GetHeight();
+		uint64_t freeArea = area - packer.GetUsedArea();
+		return area ? (float)(freeArea - packer.GetLargestFreeArea()) / (float)area : 0.0f;
+	}
+
+	Vector<AtlasStatistics> TextureManager::GetAtlasStatistics()
+	{
+		Vector<AtlasStatistics> statistics;
+		statistics.reserve(s_ManagerData->GPUTextures.size());
+
+		for (uint32_t tID = 0; tID < s_ManagerData->GPUTextures.size(); tID++)
+		{
+			const auto& gpuTexture = s_ManagerData->GPUTextures[tID];
+			const auto& packer = s_ManagerData->Packers[tID];
+
+			AtlasStatistics& atlas = statistics.emplace_back();
+			atlas.GPUTexture = gpuTexture;
+			atlas.TextureCount = (uint32_t)gpuTexture->GetMemberTextures().size();
+			atlas.Bytes = GetStorageBytes(gpuTexture->GetWidth(), gpuTexture->GetHeight(), gpuTexture->GetMipLevelCount());
+			atlas.Occupancy = packer.GetOccupancy();
+			atlas.WastedSpaceRatio = GetWastedSpaceRatio(packer);
+		}
+
+		return statistics;
+	}
+
+	// Level n averages 2^n texels, it stays inside the extruded area while 2^n <= gutter
+	uint32_t TextureManager::GetPackedMipLevelCount(uint32_t gutter)
+	{
+		uint32_t levels = 1;
+		while ((1u << levels) <= gutter)
+			levels++;
+		return levels;
+	}
+
+	// Keeps packed rects on multiples of the coarsest mip texel
+	uint32_t TextureManager::GetPackedSize(uint32_t size, uint32_t gutter, uint32_t mipLevels)
+	{
+		uint32_t alignment = 1u << (mipLevels - 1);
+		size += 2 * gutter;
+		return (size + alignment - 1) / alignment * alignment;
+	}
+
+	static uint32_t GetMipLevelCount(uint32_t gutter)
+	{
+		return s_ManagerData->MipmapsEnabled ? TextureManager::GetPackedMipLevelCount(gutter) : 1;
+	}
+
+	// Standalone atlas with its storage allocated once, packed rects are never moved
+	static void CreateGPUTexture(uint32_t width, uint32_t height, uint32_t gutter, uint32_t mipLevels)
+	{
+		auto gpuTexture = GAPI::Texture2D::Create();
+
+		gpuTexture->SetMinFilter(TextureFiltering::Linear);
+		gpuTexture->SetMagFilter(TextureFiltering::Linear);
+
+		gpuTexture->SetSWrapping(TextureWrapping::ClampToEdge);
+		gpuTexture->SetTWrapping(TextureWrapping::ClampToEdge);
+
+		gpuTexture->AllocateStorage(TextureFormat::RGBA, width, height, mipLevels);
+
+		s_ManagerData->GPUTextures.push_back(gpuTexture);
+		s_ManagerData->GPUTextureGutters.push_back(gutter);
+		s_ManagerData->Packers.emplace_back(width, height);
+	}
+
+	// Writes texture's pixels surrounded by gutter pixels, each gutter pixel repeats the nearest edge pixel
+	static void ExtrudePixels(const Texture2D* texture, uint32_t gutter, unsigned char* extruded)
+	{
+		uint32_t width = texture->GetWidth();
+		uint32_t height = texture->GetHeight();
+
+		uint32_t bytesPerPixel = texture->GetFormat() == TextureFormat::RGBA ? 4 : 3;
+		uint32_t paddedWidth = width + 2 * gutter;
+		uint32_t paddedHeight = height + 2 * gutter;
+
+		const unsigned char* pixels = texture->GetPixels();
+		for (uint32_t row = 0; row < paddedHeight; row++)
+		{
+			uint32_t sourceRow = (uint32_t)std::clamp((int)row - (int)gutter, 0, (int)height - 1);
+			const unsigned char* source = pixels + (size_t)sourceRow * width * bytesPerPixel;
+			unsigned char* destination = extruded + (size_t)row * paddedWidth * bytesPerPixel;
+
+			for (uint32_t i = 0; i < gutter; i++)
+			{
+				memcpy(destination + i * bytesPerPixel, source, bytesPerPixel);
+				memcpy(destination + (gutter + width + i) * bytesPerPixel, source + (width - 1) * bytesPerPixel, bytesPerPixel);
+			}
+
+			memcpy(destination + gutter * bytesPerPixel, source, (size_t)width * bytesPerPixel);
+		}
+	}
+
+	static uint32_t GetExtrudedSize(const Texture2D* texture, uint32_t gutter)
+	{
+		uint32_t bytesPerPixel = texture->GetFormat() == TextureFormat::RGBA ? 4 : 3;
+		return (texture->GetWidth() + 2 * gutter) * (texture->GetHeight() + 2 * gutter) * bytesPerPixel;
+	}
+
+	// Uploads texture's pixels to (x, y) of gpuTexture surrounded by gutter pixels
+	static void UploadExtruded(const Ref<GAPI::Texture2D>& gpuTexture, const Texture2D* texture, int x, int y, uint32_t gutter)
+	{
+		uint32_t paddedWidth = texture->GetWidth() + 2 * gutter;
+		uint32_t paddedHeight = texture->GetHeight() + 2 * gutter;
+		uint32_t size = GetExtrudedSize(texture, gutter);
+
+		// The copy from the unpack buffer doesn't stall the frame, too big textures take the path below
+		if (s_ManagerData->Staging)
+		{
+			auto& uploadBuffer = s_ManagerData->UploadBuffer;
+			if (unsigned char* staged = (unsigned char*)uploadBuffer->Map(size))
+			{
+				ExtrudePixels(texture, gutter, staged);
+				uploadBuffer->Unmap();
+
+				gpuTexture->SubImage(*uploadBuffer, uploadBuffer->GetMappedOffset(), paddedWidth, paddedHeight, texture->GetFormat(), x - gutter, y - gutter);
+				return;
+			}
+		}
+
+		if (gutter == 0)
+		{
+			gpuTexture->SubImage(texture->GetPixels(), paddedWidth, paddedHeight, texture->GetFormat(), x, y);
+			return;
+		}
+
+		auto& extruded = s_ManagerData->ExtrudeCache;
+		extruded.resize(size);
+		ExtrudePixels(texture, gutter, extruded.data());
+
+		gpuTexture->SubImage(extruded.data(), paddedWidth, paddedHeight, texture->GetFormat(), x - gutter, y - gutter);
+	}
+
+	void TextureManager::MapTexture(Texture2D* texture, const Ref<GAPI::Texture2D>& gpuTexture, int x, int y)
+	{
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		data.MappedTexture = gpuTexture;
+		data.MappedTextureRect = { x, y, texture->GetWidth(), texture->GetHeight() };
+		data.Revision++;
+	}
+
+	// The rect AddToGPUTexture inserted for a texture mapped to atlas index
+	static AtlasRect GetPackedRect(uint32_t index, const MasterTextureData& data)
+	{
+		uint32_t gutter = s_ManagerData->GPUTextureGutters[index];
+		uint32_t mipLevels = s_ManagerData->GPUTextures[index]->GetMipLevelCount();
+
+		return {
+			(uint32_t)data.MappedTextureRect.x - gutter, (uint32_t)data.MappedTextureRect.y - gutter,
+			TextureManager::GetPackedSize(data.Width, gutter, mipLevels), TextureManager::GetPackedSize(data.Height, gutter, mipLevels)
+		};
+	}
+
+	static void RemoveMember(GAPI::Texture2D& gpuTexture, Texture2D* texture)
+	{
+		auto& members = gpuTexture.GetMemberTextures();
+		auto it = STD_CONTAINER_FIND(members, texture);
+		OE_CORE_ASSERT(it != members.end(), "Texture is not a member of the atlas!");
+
+		*it = members.back();
+		members.pop_back();
+	}
+
+	// Frees the rect of a mapped texture, it's mapped again by MarkUsed
+	void TextureManager::UnmapTexture(Texture2D* texture)
+	{
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		uint32_t index = FindGPUTexture(data.MappedTexture.get());
+
+		s_ManagerData->Packers[index].Free(GetPackedRect(index, data));
+		RemoveMember(*data.MappedTexture, texture);
+
+		data.MappedTexture = nullptr;
+		data.Revision++;
+		s_ManagerData->MappingEpoch++;
+	}
+
+	bool TextureManager::AddToGPUTexture(uint32_t index, Texture2D* texture)
+	{
+		const auto& gpuTexture = s_ManagerData->GPUTextures[index];
+		uint32_t gutter = s_ManagerData->GPUTextureGutters[index];
+		uint32_t mipLevels = gpuTexture->GetMipLevelCount();
+
+		AtlasRect rect;
+		if (!s_ManagerData->Packers[index].Insert(GetPackedSize(texture->GetWidth(), gutter, mipLevels), GetPackedSize(texture->GetHeight(), gutter, mipLevels), rect))
+			return false;
+
+		int x = (int)(rect.X + gutter);
+		int y = (int)(rect.Y + gutter);
+
+		bool cookedLevels = false;
+
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		if (data.MappedTexture)
+		{
+			// Moved from an atlas with the same gutter, extruded texels included
+			gpuTexture->CopySubImage(*data.MappedTexture, (int)data.MappedTextureRect.x - (int)gutter, (int)data.MappedTextureRect.y - (int)gutter,
+				texture->GetWidth() + 2 * gutter, texture->GetHeight() + 2 * gutter, x - (int)gutter, y - (int)gutter);
+		}
+		else if (data.Cooked && data.Cooked->GetHeader().Gutter == gutter && data.Cooked->GetHeader().MipLevelCount == mipLevels)
+		{
+			// Cooked for this layout, every level is uploaded straight from the mapping
+			const auto& cooked = *data.Cooked;
+			OE_CORE_ASSERT(cooked.GetHeader().PaddedWidth == rect.Width && cooked.GetHeader().PaddedHeight == rect.Height, "Cooked texture doesn't match its packed rect!");
+
+			for (uint32_t level = 0; level < mipLevels; level++)
+				gpuTexture->SubImage(cooked.GetLevel(level), cooked.GetLevelWidth(level), cooked.GetLevelHeight(level), TextureFormat::RGBA, rect.X >> level, rect.Y >> level, level);
+
+			cookedLevels = true;
+		}
+		else
+		{
+			// Released pixels are read again just for the upload, transparent if the file is gone
+			if (!texture->ReloadPixels())
+				data.Pixels = (uint8_t*)calloc((size_t)data.Width * data.Height, data.Format == TextureFormat::RGBA ? 4 : 3);
+
+			UploadExtruded(gpuTexture, texture, x, y, gutter);
+			ReleaseTexturePixels(texture);
+		}
+
+		// Mip levels are regenerated once for everything packed into the atlas this frame, cooked ones are already written
+		if (!cookedLevels && mipLevels > 1 && STD_CONTAINER_FIND(s_ManagerData->MipmapsDirty, gpuTexture) == s_ManagerData->MipmapsDirty.end())
+			s_ManagerData->MipmapsDirty.push_back(gpuTexture);
+
+		gpuTexture->GetMemberTextures().push_back(texture);
+		MapTexture(texture, gpuTexture, x, y);
+		return true;
+	}
+
+	void TextureManager::AddToNewGPUTexture(Texture2D* texture)
+	{
+		uint32_t gutter = s_ManagerData->Gutter;
+		uint32_t mipLevels = GetMipLevelCount(gutter);
+
+		uint32_t width = GetPackedSize(texture->GetWidth(), gutter, mipLevels);
+		uint32_t height = GetPackedSize(texture->GetHeight(), gutter, mipLevels);
+
+		// Page sized so later textures can join it, bigger textures get an atlas of their own
+		uint32_t pageSize = s_ManagerData->PageSize;
+		if (width <= pageSize && height <= pageSize)
+			width = height = pageSize;
+
+		CreateGPUTexture(width, height, gutter, mipLevels);
+		AddToGPUTexture((uint32_t)s_ManagerData->GPUTextures.size() - 1, texture);
+	}
+
+	// Takes the next free layer of the page array, growing it if needed; nullptr when the array is full
+	Ref<GAPI::Texture2D> TextureManager::CreatePage()
+	{
+		auto& pages = s_ManagerData->Pages;
+
+		if (!pages)
+		{
+			s_ManagerData->PageGutter = s_ManagerData->Gutter;
+			uint32_t mipLevels = GetMipLevelCount(s_ManagerData->PageGutter);
+			pages = GAPI::Texture2DArray::Create(TextureFormat::RGBA, s_ManagerData->PageSize, s_ManagerData->PageSize, mipLevels);
+
+			pages->SetMinFilter(TextureFiltering::Linear);
+			pages->SetMagFilter(TextureFiltering::Linear);
+
+			pages->SetSWrapping(TextureWrapping::ClampToEdge);
+			pages->SetTWrapping(TextureWrapping::ClampToEdge);
+
+			pages->SetLayerCount(std::min(TextureManagerData::InitialPageCount, RenderCommand::GetMaxArrayTextureLayers()));
+		}
+
+		uint32_t layerCount = pages->GetLayerCount();
+		if (s_ManagerData->PageCount == layerCount)
+		{
+			uint32_t maxLayerCount = RenderCommand::GetMaxArrayTextureLayers();
+			if (layerCount == maxLayerCount)
+				return nullptr;
+
+			pages->SetLayerCount(std::min(std::max(2 * layerCount, 1u), maxLayerCount));
+
+			// Reallocation gives the layer views new renderer IDs
+			for (uint32_t layer = 0; layer < s_ManagerData->PageCount; layer++)
+				for (Texture2D* member : pages->GetLayer(layer)->GetMemberTextures())
+					std::get<MasterTextureData>(member->m_Data).Revision++;
+			s_ManagerData->MappingEpoch++;
+		}
+
+		auto page = pages->GetLayer(s_ManagerData->PageCount++);
+
+		s_ManagerData->GPUTextures.push_back(page);
+		s_ManagerData->GPUTextureGutters.push_back(s_ManagerData->PageGutter);
+		s_ManagerData->Packers.emplace_back(s_ManagerData->PageSize, s_ManagerData->PageSize);
+		return page;
+	}
+
+	// Whether the padded texture fits in an empty page
+	static bool FitsPage(const Texture2D* texture)
+	{
+		if (!s_ManagerData->Paged)
+			return false;
+
+		uint32_t gutter = s_ManagerData->Pages ? s_ManagerData->PageGutter : s_ManagerData->Gutter;
+		uint32_t mipLevels = s_ManagerData->Pages ? s_ManagerData->Pages->GetMipLevelCount() : GetMipLevelCount(gutter);
+
+		return TextureManager::GetPackedSize(texture->GetWidth(), gutter, mipLevels) <= s_ManagerData->PageSize &&
+			TextureManager::GetPackedSize(texture->GetHeight(), gutter, mipLevels) <= s_ManagerData->PageSize;
+	}
+
+	bool TextureManager::AddToNewPage(Texture2D* texture)
+	{
+		if (!CreatePage())
+			return false;
+
+		return AddToGPUTexture((uint32_t)s_ManagerData->GPUTextures.size() - 1, texture);
 	}
 
 	void TextureManager::AddTexture(Ref<Texture2D>& texture)
@@ -39,8 +533,8 @@ namespace OverEngine
 			return;
 		}
 
-		auto it = STD_CONTAINER_FIND(s_ManagerData->MasterTextures, texture);
-		if (it != s_ManagerData->MasterTextures.end())
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		if (data.Managed)
 		{
 			OE_CORE_WARN("Texture is already handeled by TextureManager!");
 			return;
@@ -48,152 +542,399 @@ namespace OverEngine
 
 		// Now we should handle a new valid Texture
 
-		s_ManagerData->MasterTextures.push_back(texture);
+		data.Managed = true;
+		data.LastUsedFrame = s_ManagerData->Frame;
+		s_ManagerData->MasterTextures.push_back(texture.get());
 
-		if (s_ManagerData->GPUTextures.empty())
-		{
-			s_ManagerData->GPUTextures.push_back(GAPI::Texture2D::Create());
-			s_ManagerData->RectanglePackers.push_back(stbrp_context());
+		PlaceTexture(texture.get());
+	}
 
-			s_ManagerData->GPUTextures[0]->SetMinFilter(TextureFiltering::Nearest);
-			s_ManagerData->GPUTextures[0]->SetMagFilter(TextureFiltering::Nearest);
+	void TextureManager::RemoveTexture(Texture2D* texture)
+	{
+		if (!s_ManagerData)
+			return;
 
-			s_ManagerData->GPUTextures[0]->SetSWrapping(TextureWrapping::ClampToBorder);
-			s_ManagerData->GPUTextures[0]->SetTWrapping(TextureWrapping::ClampToBorder);
-			s_ManagerData->GPUTextures[0]->SetBorderColor({ 1.0f, 0.5f, 1.0f, 1.0f });
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
+		if (data.MappedTexture)
+			UnmapTexture(texture);
+		data.Managed = false;
 
-			s_ManagerData->GPUTextures[0]->AllocateStorage(TextureFormat::RGBA, texture->GetWidth(), texture->GetHeight());
-			s_ManagerData->GPUTextures[0]->SubImage(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(), texture->GetFormat());
-			s_ManagerData->GPUTextures[0]->GetMemberTextures().push_back(texture);
-			std::get<MasterTextureData>(texture->m_Data).MappedTexture = s_ManagerData->GPUTextures[0];
-			std::get<MasterTextureData>(texture->m_Data).MappedTextureRect = {
-				0, 0, texture->GetWidth(), texture->GetHeight()
-			};
+		auto& masterTextures = s_ManagerData->MasterTextures;
+		auto it = STD_CONTAINER_FIND(masterTextures, texture);
+		*it = masterTextures.back();
+		masterTextures.pop_back();
+	}
 
+	void TextureManager::MarkUsed(Texture2D& texture)
+	{
+		Texture2D* master = &texture;
+		if (texture.GetType() == TextureType::Subtexture)
+			master = std::get<SubTextureData>(texture.m_Data).Parent.get();
+		else if (texture.GetType() != TextureType::Master)
 			return;
+
+		auto& data = std::get<MasterTextureData>(master->m_Data);
+		data.LastUsedFrame = s_ManagerData->Frame;
+
+		if (data.Managed && !data.MappedTexture)
+			PlaceTexture(master);
+	}
+
+	// Whether a texture of that kind may be packed into atlas index
+	static bool CanPackInto(uint32_t index, bool paged)
+	{
+		bool isPage = s_ManagerData->GPUTextures[index]->GetArrayLayer() != -1;
+		if (isPage != paged)
+			return false;
+
+		// Standalone atlases keep the gutter they were created with
+		return isPage || s_ManagerData->GPUTextureGutters[index] == s_ManagerData->Gutter;
+	}
+
+	// Storage allocated if texture had to go to a new atlas
+	static uint64_t GetNewStorageBytes(const Texture2D* texture, bool paged)
+	{
+		uint32_t pageSize = s_ManagerData->PageSize;
+
+		if (paged)
+		{
+			const auto& pages = s_ManagerData->Pages;
+			if (!pages)
+				return GetStorageBytes(pageSize, pageSize, GetMipLevelCount(s_ManagerData->Gutter)) * TextureManagerData::InitialPageCount;
+
+			// Spare layers are free, a full array doubles
+			if (s_ManagerData->PageCount < pages->GetLayerCount())
+				return 0;
+			return GetStorageBytes(pageSize, pageSize, pages->GetMipLevelCount()) * pages->GetLayerCount();
 		}
 
-		// Loop through all GPUTextures to put our new Texture into them
-		uint32_t maxSize = RenderCommand::GetMaxTextureSize();
-		float wastedSpaceRatioIncrementValue = 0.03f;
+		uint32_t mipLevels = GetMipLevelCount(s_ManagerData->Gutter);
+		uint32_t width = TextureManager::GetPackedSize(texture->GetWidth(), s_ManagerData->Gutter, mipLevels);
+		uint32_t height = TextureManager::GetPackedSize(texture->GetHeight(), s_ManagerData->Gutter, mipLevels);
+		if (width <= pageSize && height <= pageSize)
+			width = height = pageSize;
+		return GetStorageBytes(width, height, mipLevels);
+	}
+
+	void TextureManager::PlaceTexture(Texture2D* texture)
+	{
+		// First atlas with a free rect big enough, existing members stay where they are
+		bool paged = FitsPage(texture);
 
 		for (uint32_t tID = 0; tID < s_ManagerData->GPUTextures.size(); tID++)
 		{
-			uint32_t textureHeightSum = 0;
-			uint32_t textureWidthSum = 0;
+			if (CanPackInto(tID, paged) && AddToGPUTexture(tID, texture))
+				return;
+		}
 
-			float wastedSpaceRatio = 0.0f;
+		// Over budget, cold textures make room before more storage is allocated
+		uint64_t budget = s_ManagerData->MemoryBudget;
+		if (budget && GetAllocatedBytes() + GetNewStorageBytes(texture, paged) > budget)
+		{
+			uint32_t freedIndex;
+			while (EvictColdTexture(paged, &freedIndex))
+			{
+				if (AddToGPUTexture(freedIndex, texture))
+					return;
+			}
+		}
 
-			Ref<GAPI::Texture2D> currentGPUTexture = s_ManagerData->GPUTextures[tID];
-			stbrp_context* currentContext = &s_ManagerData->RectanglePackers[tID];
+		// We need to create another GPUTexture and ...
+		if (!paged || !AddToNewPage(texture))
+			AddToNewGPUTexture(texture);
+	}
+
+	// Unmaps the least recently used texture not used this frame from an atlas of that kind
+	bool TextureManager::EvictColdTexture(bool paged, uint32_t* freedIndex)
+	{
+		Texture2D* coldest = nullptr;
+		uint32_t coldestIndex = 0;
+		uint64_t coldestFrame = s_ManagerData->Frame;
+
+		for (Texture2D* texture : s_ManagerData->MasterTextures)
+		{
+			const auto& data = std::get<MasterTextureData>(texture->m_Data);
+			if (!data.MappedTexture || data.LastUsedFrame >= coldestFrame)
+				continue;
+
+			uint32_t index = FindGPUTexture(data.MappedTexture.get());
+			if (!CanPackInto(index, paged))
+				continue;
 
-			auto& currentGPUTextureMembers = currentGPUTexture->GetMemberTextures();
-			uint32_t currentGPUTextureMemberCount = (uint32_t)currentGPUTextureMembers.size();
+			coldest = texture;
+			coldestIndex = index;
+			coldestFrame = data.LastUsedFrame;
+		}
+
+		if (!coldest)
+			return false;
 
-			s_ManagerData->RectCache.clear();
-			if (s_ManagerData->RectCache.capacity() < currentGPUTextureMemberCount + (uint32_t)1)
-				s_ManagerData->RectCache.reserve(currentGPUTextureMemberCount + (uint32_t)1);
+		UnmapTexture(coldest);
+		*freedIndex = coldestIndex;
+		return true;
+	}
+
+	void TextureManager::ReleaseGPUTexture(uint32_t index)
+	{
+		OE_CORE_ASSERT(s_ManagerData->GPUTextures[index]->GetArrayLayer() == -1, "Pages can't be released!");
+		OE_CORE_ASSERT(s_ManagerData->GPUTextures[index]->GetMemberTextures().empty(), "Releasing an atlas with textures!");
+
+		s_ManagerData->GPUTextures.erase(s_ManagerData->GPUTextures.begin() + index);
+		s_ManagerData->GPUTextureGutters.erase(s_ManagerData->GPUTextureGutters.begin() + index);
+		s_ManagerData->Packers.erase(s_ManagerData->Packers.begin() + index);
+	}
+
+	void TextureManager::EnforceMemoryBudget()
+	{
+		auto& gpuTextures = s_ManagerData->GPUTextures;
 
-			for (auto& t : currentGPUTextureMembers)
+		// Empty standalone atlases are released whatever the budget
+		for (uint32_t tID = (uint32_t)gpuTextures.size(); tID-- > 0;)
+		{
+			if (gpuTextures[tID]->GetArrayLayer() == -1 && gpuTextures[tID]->GetMemberTextures().empty())
+				ReleaseGPUTexture(tID);
+		}
+
+		uint64_t budget = s_ManagerData->MemoryBudget;
+		if (!budget)
+			return;
+
+		// Only standalone atlases can give storage back, the one used longest ago goes first
+		while (GetAllocatedBytes() > budget)
+		{
+			uint32_t coldest = (uint32_t)gpuTextures.size();
+			uint64_t coldestFrame = s_ManagerData->Frame;
+
+			for (uint32_t tID = 0; tID < gpuTextures.size(); tID++)
 			{
-				stbrp_rect rect;
-				rect.w = t->GetWidth();
-				rect.h = t->GetHeight();
-				textureWidthSum += rect.w;
-				textureHeightSum += rect.h;
-				s_ManagerData->RectCache.push_back(rect);
+				if (gpuTextures[tID]->GetArrayLayer() != -1)
+					continue;
+
+				uint64_t lastUsedFrame = 0;
+				for (Texture2D* member : gpuTextures[tID]->GetMemberTextures())
+					lastUsedFrame = std::max(lastUsedFrame, std::get<MasterTextureData>(member->m_Data).LastUsedFrame);
+
+				if (lastUsedFrame < coldestFrame)
+				{
+					coldest = tID;
+					coldestFrame = lastUsedFrame;
+				}
 			}
 
-			stbrp_rect rect;
-			rect.w = texture->GetWidth();
-			rect.h = texture->GetHeight();
-			textureWidthSum += rect.w;
-			textureHeightSum += rect.h;
-			s_ManagerData->RectCache.push_back(rect);
+			if (coldest == gpuTextures.size())
+				break;
 
-			uint32_t totalWidth = (uint32_t)(textureWidthSum * (1 + wastedSpaceRatio));
-			uint32_t totalHeigth = (uint32_t)(textureHeightSum * (1 + wastedSpaceRatio));
+			auto& members = gpuTextures[coldest]->GetMemberTextures();
+			while (!members.empty())
+				UnmapTexture(members.back());
+			ReleaseGPUTexture(coldest);
+		}
+	}
+
+	// Packs texture into a fuller atlas of the same kind, its rect in atlas from is freed after
+	bool TextureManager::MoveTexture(Texture2D* texture, uint32_t from)
+	{
+		auto& data = std::get<MasterTextureData>(texture->m_Data);
 
-			s_ManagerData->NodeCache.clear();
-			if (s_ManagerData->NodeCache.capacity() < totalWidth)
-				s_ManagerData->NodeCache.reserve(totalWidth);
+		Ref<GAPI::Texture2D> source = data.MappedTexture;
+		AtlasRect sourceRect = GetPackedRect(from, data);
 
-			for (uint32_t i = 0; i < totalWidth; i++)
+		bool paged = source->GetArrayLayer() != -1;
+		float occupancy = s_ManagerData->Packers[from].GetOccupancy();
+
+		for (uint32_t tID = 0; tID < s_ManagerData->GPUTextures.size(); tID++)
+		{
+			if (tID == from || (s_ManagerData->GPUTextures[tID]->GetArrayLayer() != -1) != paged)
+				continue;
+
+			if (s_ManagerData->GPUTextureGutters[tID] != s_ManagerData->GPUTextureGutters[from])
+				continue;
+
+			// Never into an emptier atlas, textures would bounce between them
+			if (s_ManagerData->Packers[tID].GetOccupancy() < occupancy)
+				continue;
+
+			if (AddToGPUTexture(tID, texture))
 			{
-				stbrp_node node;
-				s_ManagerData->NodeCache.push_back(node);
+				s_ManagerData->Packers[from].Free(sourceRect);
+				RemoveMember(*source, texture);
+				s_ManagerData->MappingEpoch++;
+				return true;
 			}
+		}
+
+		return false;
+	}
 
-			stbrp_init_target(currentContext, totalWidth, totalHeigth, s_ManagerData->NodeCache.data(), (int)s_ManagerData->NodeCache.size());
-			bool allPacked = stbrp_pack_rects(currentContext, s_ManagerData->RectCache.data(), (int)s_ManagerData->RectCache.size());
+	/**
+	 * Evacuates the sparsest atlas with scattered free space into the others, one texture
+	 * at a time until the time slice is spent. Emptied pages are whole again (the packer
+	 * starts over), emptied standalone atlases are released.
+	 */
+	void TextureManager::Defragment()
+	{
+		if (!s_ManagerData->Defragmentation || s_ManagerData->Frame < s_ManagerData->DefragIdleUntilFrame)
+			return;
 
-			bool textureOutOfSize = false;
+		double start = Time::GetTimeDouble();
 
-			if (totalHeigth >= maxSize || totalWidth >= maxSize)
-				textureOutOfSize = true;
+		do
+		{
+			uint32_t victim = (uint32_t)s_ManagerData->GPUTextures.size();
+			float lowestOccupancy = TextureManagerData::DefragMaxOccupancy;
 
-			while (!allPacked)
+			for (uint32_t tID = 0; tID < s_ManagerData->GPUTextures.size(); tID++)
 			{
-				wastedSpaceRatio += wastedSpaceRatioIncrementValue;
-
-				totalWidth = (uint32_t)(textureWidthSum * (1 + wastedSpaceRatio));
-				totalHeigth = (uint32_t)(textureHeightSum * (1 + wastedSpaceRatio));
+				const auto& packer = s_ManagerData->Packers[tID];
+				if (s_ManagerData->GPUTextures[tID]->GetMemberTextures().empty() || GetWastedSpaceRatio(packer) < TextureManagerData::DefragMinWastedSpaceRatio)
+					continue;
 
-				if (totalHeigth >= maxSize || totalWidth >= maxSize)
+				if (packer.GetOccupancy() <= lowestOccupancy)
 				{
-					textureOutOfSize = true;
-					break;
+					victim = tID;
+					lowestOccupancy = packer.GetOccupancy();
 				}
+			}
 
-				stbrp_init_target(currentContext, totalWidth, totalHeigth, s_ManagerData->NodeCache.data(), (int)s_ManagerData->NodeCache.size());
-				allPacked = stbrp_pack_rects(currentContext, s_ManagerData->RectCache.data(), (int)s_ManagerData->RectCache.size());
+			if (victim == s_ManagerData->GPUTextures.size() || !MoveTexture(s_ManagerData->GPUTextures[victim]->GetMemberTextures().back(), victim))
+			{
+				s_ManagerData->DefragIdleUntilFrame = s_ManagerData->Frame + TextureManagerData::DefragRetryFrames;
+				return;
 			}
 
-			if (textureOutOfSize)
-				continue;
+			const auto& gpuTexture = s_ManagerData->GPUTextures[victim];
+			if (gpuTexture->GetArrayLayer() == -1 && gpuTexture->GetMemberTextures().empty())
+				ReleaseGPUTexture(victim);
+		} while ((Time::GetTimeDouble() - start) * 1000.0 < s_ManagerData->DefragMilliseconds);
+	}
+
+	void TextureManager::LoadAsync(const Ref<Texture2D>& placeholder, const String& path)
+	{
+		OE_CORE_ASSERT(placeholder->GetType() == TextureType::Placeholder, "Only placeholders can be loaded asynchronously!");
 
-			// Packed!
-			currentGPUTextureMembers.push_back(texture);
-			currentGPUTexture->AllocateStorage(TextureFormat::RGBA, totalWidth, totalHeigth);
+		if (!s_ManagerData->Decoders)
+			s_ManagerData->Decoders = CreateScope<ThreadPool>();
 
-			for (uint32_t i = 0; i < currentGPUTextureMemberCount + 1; i++)
+		s_ManagerData->PendingLoadCount++;
+
+		std::weak_ptr<Texture2D> texture = placeholder;
+		s_ManagerData->Decoders->Submit([texture, path]() {
+			// Dropped before its turn
+			if (texture.expired())
+			{
+				s_ManagerData->PendingLoadCount--;
+				return;
+			}
+
+			int width, height, channels;
+			stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+
+			if (!pixels || (channels != 3 && channels != 4))
 			{
-				currentGPUTexture->SubImage(
-					currentGPUTextureMembers[i]->GetPixels(),
-					s_ManagerData->RectCache[i].w, s_ManagerData->RectCache[i].h,
-					currentGPUTextureMembers[i]->GetFormat(),
-					s_ManagerData->RectCache[i].x, s_ManagerData->RectCache[i].y
-				);
-
-				std::get<MasterTextureData>(currentGPUTextureMembers[i]->m_Data).MappedTextureRect = {
-					s_ManagerData->RectCache[i].x, s_ManagerData->RectCache[i].y,
-					s_ManagerData->RectCache[i].w, s_ManagerData->RectCache[i].h
-				};
+				OE_CORE_ERROR("Failed to load image '{0}'!", path);
+				stbi_image_free(pixels);
+				s_ManagerData->PendingLoadCount--;
+				return;
 			}
 
-			std::get<MasterTextureData>(texture->m_Data).MappedTexture = currentGPUTexture;
+			std::lock_guard<std::mutex> lock(s_ManagerData->DecodedMutex);
+			s_ManagerData->Decoded.push_back({ texture, path, pixels, (uint32_t)width, (uint32_t)height, channels == 4 ? TextureFormat::RGBA : TextureFormat::RGB });
+		});
+	}
+
+	void TextureManager::SetUploadBudget(uint32_t bytesPerFrame)
+	{
+		s_ManagerData->UploadBudget = bytesPerFrame;
+
+		// Recreated with the new region size by the next upload
+		s_ManagerData->UploadBuffer = nullptr;
+	}
+
+	uint32_t TextureManager::GetUploadBudget() { return s_ManagerData->UploadBudget; }
+	uint32_t TextureManager::GetPendingLoadCount() { return s_ManagerData->PendingLoadCount; }
+	uint32_t TextureManager::GetLoadEpoch() { return s_ManagerData->LoadEpoch; }
+
+	void TextureManager::UploadDecodedTextures()
+	{
+		auto& pendingUploads = s_ManagerData->PendingUploads;
+
+		{
+			std::lock_guard<std::mutex> lock(s_ManagerData->DecodedMutex);
+			pendingUploads.insert(pendingUploads.end(), s_ManagerData->Decoded.begin(), s_ManagerData->Decoded.end());
+			s_ManagerData->Decoded.clear();
+		}
+
+		if (pendingUploads.empty())
 			return;
+
+		if (!s_ManagerData->UploadBuffer)
+			s_ManagerData->UploadBuffer = PixelUnpackBuffer::Create(s_ManagerData->UploadBudget);
+		else
+			s_ManagerData->UploadBuffer->NextRegion();
+
+		s_ManagerData->Staging = true;
+
+		uint32_t uploaded = 0;
+		while (!pendingUploads.empty())
+		{
+			DecodedImage image = pendingUploads.front();
+			Ref<Texture2D> texture = image.Texture.lock();
+
+			// Gutter isn't known before packing, the bigger one is assumed
+			uint32_t gutter = std::max(s_ManagerData->Gutter, s_ManagerData->PageGutter);
+			uint32_t bytesPerPixel = image.Format == TextureFormat::RGBA ? 4 : 3;
+			uint32_t size = (image.Width + 2 * gutter) * (image.Height + 2 * gutter) * bytesPerPixel;
+
+			if (texture && uploaded && uploaded + size > s_ManagerData->UploadBudget)
+				break;
+
+			pendingUploads.pop_front();
+			s_ManagerData->PendingLoadCount--;
+
+			if (!texture)
+			{
+				stbi_image_free(image.Pixels);
+				continue;
+			}
+
+			MasterTextureData data;
+			data.Asset = std::get<PlaceHolderTextureData>(texture->m_Data).Asset;
+			data.Format = image.Format;
+			data.Width = image.Width;
+			data.Height = image.Height;
+			data.Filtering = TextureFiltering::Linear;
+			data.Pixels = image.Pixels;
+			data.SourcePath = image.Path;
+
+			texture->m_Type = TextureType::Master;
+			texture->m_Data = data;
+			AddTexture(texture);
+			s_ManagerData->LoadEpoch++;
+
+			uploaded += size;
 		}
 
-		// We need to create another GPUTexture and ...
-		s_ManagerData->GPUTextures.push_back(GAPI::Texture2D::Create());
-		s_ManagerData->RectanglePackers.push_back(stbrp_context());
+		s_ManagerData->Staging = false;
+	}
 
-		auto currentGPUTexture = s_ManagerData->GPUTextures[s_ManagerData->GPUTextures.size() - 1];
+	void TextureManager::GenerateDirtyMipmaps()
+	{
+		for (const auto& gpuTexture : s_ManagerData->MipmapsDirty)
+			gpuTexture->GenerateMipmaps();
+		s_ManagerData->MipmapsDirty.clear();
+	}
+
+	void TextureManager::Update()
+	{
+		OE_PROFILE_FUNCTION();
 
-		currentGPUTexture->SetMinFilter(TextureFiltering::Nearest);
-		currentGPUTexture->SetMagFilter(TextureFiltering::Nearest);
+		UploadDecodedTextures();
 
-		currentGPUTexture->SetSWrapping(TextureWrapping::ClampToBorder);
-		currentGPUTexture->SetTWrapping(TextureWrapping::ClampToBorder);
-		currentGPUTexture->SetBorderColor({ 1.0f, 0.0f, 1.0f, 1.0f });
+		// Runs between frames, no pending quads reference the moved rects
+		EnforceMemoryBudget();
+		Defragment();
+		GenerateDirtyMipmaps();
 
-		currentGPUTexture->AllocateStorage(TextureFormat::RGBA, texture->GetWidth(), texture->GetHeight());
-		currentGPUTexture->SubImage(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(), texture->GetFormat());
-		currentGPUTexture->GetMemberTextures().push_back(texture);
-		std::get<MasterTextureData>(texture->m_Data).MappedTexture = currentGPUTexture;
-		std::get<MasterTextureData>(texture->m_Data).MappedTextureRect = {
-			0, 0, texture->GetWidth(), texture->GetHeight()
-		};
+		s_ManagerData->Frame++;
 	}
 }
@@ -4,6 +4,18 @@
 
 namespace OverEngine
 {
+	struct AtlasStatistics
+	{
+		Ref<GAPI::Texture2D> GPUTexture; // The page or standalone atlas
+		uint32_t TextureCount = 0;
+		uint64_t Bytes = 0; // Storage including mip levels
+
+		float Occupancy = 0.0f; // Packed area (gutters included) over atlas area
+
+		// Free area outside the largest free rect over atlas area, space too scattered to take big textures
+		float WastedSpaceRatio = 0.0f;
+	};
+
 	class TextureManager
 	{
 	public:
@@ -11,5 +23,114 @@ namespace OverEngine
 		static void Shutdown();
 
 		static void AddTexture(Ref<Texture2D>& texture);
+
+		// Called by ~Texture2D, frees its rect in the atlas
+		static void RemoveTexture(Texture2D* texture);
+
+		/**
+		 * Stamps the (parent) master texture as used in the current frame, maps it
+		 * back to an atlas if it was evicted. Renderer2D calls it for every texture
+		 * it draws, other users of GetGPUTexture() / GetRect() should too.
+		 */
+		static void MarkUsed(Texture2D& texture);
+
+		// Once per frame: advances the frame, enforces the memory budget and runs a slice of defragmentation
+		static void Update();
+
+		/**
+		 * Regenerates the mip levels of every atlas textures were packed into since the last call, once per atlas.
+		 * Update calls it, Renderer2D too before drawing so textures added during the frame aren't sampled with stale levels.
+		 */
+		static void GenerateDirtyMipmaps();
+		static uint64_t GetFrame();
+
+		// Incremented whenever mapped textures move, descriptors cached without a revision check must be refreshed
+		static uint32_t GetMappingEpoch();
+
+		/**
+		 * Atlas storage (bytes, 0 for unlimited) not grown past unless nothing can be evicted.
+		 * Textures not used in the current frame are evicted least recently used first,
+		 * emptied standalone atlases are released. Pages are kept once allocated.
+		 */
+		static void SetMemoryBudget(uint64_t bytes);
+		static uint64_t GetMemoryBudget();
+		static uint64_t GetAllocatedBytes();
+
+		/**
+		 * Each Update, moves textures out of the atlas wasting the most space into the
+		 * free space of the others, until millisecondsPerFrame is spent.
+		 */
+		static void SetDefragmentation(bool enabled, float millisecondsPerFrame = 0.5f);
+		static bool IsDefragmentationEnabled();
+
+		static Vector<AtlasStatistics> GetAtlasStatistics();
+
+		/**
+		 * Decodes path on a worker thread, an Update then turns placeholder into the master texture and
+		 * packs it. Those uploads are staged in a ring of pixel unpack buffers, at most the upload
+		 * budget each frame (a texture bigger than the budget gets a frame of its own).
+		 */
+		static void LoadAsync(const Ref<Texture2D>& placeholder, const String& path);
+		static void SetUploadBudget(uint32_t bytesPerFrame);
+		static uint32_t GetUploadBudget();
+
+		// Textures decoding or waiting for their upload
+		static uint32_t GetPendingLoadCount();
+
+		// Incremented whenever Update turns placeholders into master textures, anything caching a placeholder should look again
+		static uint32_t GetLoadEpoch();
+
+		/**
+		 * Pixels of extruded edge around each packed texture, keeps hardware
+		 * filtering and mip levels from bleeding neighbours into each other.
+		 * Only affects atlases packed after the call.
+		 */
+		static void SetGutter(uint32_t gutter);
+		static uint32_t GetGutter();
+
+		// Gutter the atlas was packed with, 0 for textures not owned by TextureManager
+		static uint32_t GetAtlasGutter(const Ref<GAPI::Texture2D>& atlas);
+
+		static void SetMipmapsEnabled(bool enabled);
+		static bool IsMipmapsEnabled();
+
+		// Packed layout for a gutter (mipmaps enabled), TextureCooker lays cooked textures out the same way
+		static uint32_t GetPackedMipLevelCount(uint32_t gutter);
+		static uint32_t GetPackedSize(uint32_t size, uint32_t gutter, uint32_t mipLevels);
+
+		/**
+		 * Frees the pixels of textures loaded from a file once they are uploaded. Moves between
+		 * atlases copy on the GPU, evicted textures read their file again when used.
+		 */
+		static void SetReleasePixels(bool release);
+		static bool IsReleasingPixels();
+
+		/**
+		 * Packs atlases as equally sized layers (pages) of one texture array, so every
+		 * atlas can be sampled through a single binding. On by default when texture
+		 * arrays are supported, textures bigger than a page still get their own atlas.
+		 * pageSize is rounded down to a power of two and also sizes standalone atlases.
+		 * Only affects textures added after the call.
+		 */
+		static void SetPaged(bool paged, uint32_t pageSize = 2048);
+		static bool IsPaged();
+
+		// nullptr until the first page is needed
+		static const Ref<GAPI::Texture2DArray>& GetPages();
+	private:
+		static void PlaceTexture(Texture2D* texture);
+		static bool AddToGPUTexture(uint32_t index, Texture2D* texture);
+		static void AddToNewGPUTexture(Texture2D* texture);
+		static bool AddToNewPage(Texture2D* texture);
+		static Ref<GAPI::Texture2D> CreatePage();
+		static void MapTexture(Texture2D* texture, const Ref<GAPI::Texture2D>& gpuTexture, int x, int y);
+		static void UnmapTexture(Texture2D* texture);
+		static void ReleaseTexturePixels(Texture2D* texture);
+		static bool MoveTexture(Texture2D* texture, uint32_t from);
+		static void ReleaseGPUTexture(uint32_t index);
+		static bool EvictColdTexture(bool paged, uint32_t* freedIndex);
+		static void EnforceMemoryBudget();
+		static void Defragment();
+		static void UploadDecodedTextures();
 	};
 }
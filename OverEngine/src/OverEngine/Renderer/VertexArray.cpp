@@ -3,6 +3,7 @@
 
 #include "RendererAPI.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 namespace OverEngine
 {
@@ -12,6 +13,7 @@ namespace OverEngine
 		{
 		case RendererAPI::API::None:    OE_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLVertexArray>();
+		case RendererAPI::API::Null:    return CreateRef<NullVertexArray>();
 		}
 
 		OE_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -14,7 +14,12 @@ namespace OverEngine
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
-		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) = 0;
+		/**
+		 * instanceDivisor : 0 for per vertex attributes,
+		 *                   N to advance the attributes once every N instances
+		 */
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor = 0) = 0;
+		virtual void AddVertexBuffer(const Ref<StreamingBuffer>& streamingBuffer, uint32_t instanceDivisor = 0) = 0;
 		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) = 0;
 
 		virtual const Vector<Ref<VertexBuffer>>& GetVertexBuffers() const = 0;
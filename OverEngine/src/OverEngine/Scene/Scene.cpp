@@ -6,6 +6,7 @@
 #include "TransformComponent.h"
 
 #include "OverEngine/Renderer/Renderer2D.h"
+#include "OverEngine/Renderer/TextureManager.h"
 #include "OverEngine/Physics/PhysicWorld2D.h"
 #include "OverEngine/Assets/Texture2DAsset.h"
 
@@ -14,6 +15,14 @@
 #include "OverEngine/Core/Serialization/YamlConverters.h"
 #include <yaml-cpp/yaml.h>
 #include <fstream>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define OE_SCENE_CULLING_SSE 1
+	#include <xmmintrin.h>
+#else
+	#define OE_SCENE_CULLING_SSE 0
+#endif
 
 
 namespace OverEngine
@@ -21,6 +30,7 @@ namespace OverEngine
 	Scene::Scene(const SceneSettings& settings)
 		: m_PhysicWorld2D(nullptr)
 	{
+		ConnectSignals();
 	}
 
 	template<typename T>
@@ -41,6 +51,8 @@ namespace OverEngine
 		: m_Registry(), m_ViewportWidth(other.m_ViewportWidth), m_ViewportHeight(other.m_ViewportHeight),
 		  m_RootHandles(other.m_RootHandles), m_ComponentList(other.m_ComponentList)
 	{
+		ConnectSignals();
+
 		const auto& reg = other.m_Registry;
 		m_Registry.assign(reg.data(), reg.data() + reg.size());
 
@@ -55,6 +67,13 @@ namespace OverEngine
 
 	Scene::~Scene()
 	{
+		m_RetainedSprites = nullptr;
+	}
+
+	void Scene::ConnectSignals()
+	{
+		m_Registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteConstructed>(*this);
+		m_Registry.on_destroy<SpriteRendererComponent>().connect<&Scene::OnSpriteDestroyed>(*this);
 	}
 
 	Entity Scene::CreateEntity(const String& name, uint64_t uuid)
@@ -169,60 +188,394 @@ namespace OverEngine
 		});
 	}
 
-	void Scene::RenderSprites()
+	static bool IsTexturedSprite(const SpriteRendererComponent& sprite)
+	{
+		return sprite.Sprite && sprite.Sprite->GetType() != TextureType::Placeholder;
+	}
+
+	// Drawn once its texture is loaded, not as a flat tint until then
+	static bool IsLoadingSprite(const SpriteRendererComponent& sprite)
+	{
+		return sprite.Sprite && sprite.Sprite->GetType() == TextureType::Placeholder;
+	}
+
+	static TexturedQuadExtraData GetSpriteExtraData(const SpriteRendererComponent& sprite)
+	{
+		TexturedQuadExtraData data;
+		data.Tint = sprite.Tint;
+		data.Tiling = sprite.Tiling;
+		data.Offset = sprite.Offset;
+		data.Flip = sprite.Flip;
+		data.Wrapping = sprite.Wrapping;
+		data.Filtering = sprite.Filtering;
+		data.AlphaClipThreshold = sprite.AlphaClipThreshold;
+		data.TextureBorderColor = sprite.TextureBorderColor;
+		return data;
+	}
+
+	static void SubmitSprite(const SpriteRendererComponent& sprite, const TransformComponent& transform)
+	{
+		if (IsLoadingSprite(sprite))
+			return;
+
+		if (IsTexturedSprite(sprite))
+			Renderer2D::DrawQuad(transform, sprite.Sprite, GetSpriteExtraData(sprite));
+		else
+			Renderer2D::DrawQuad(transform, sprite.Tint, sprite.AlphaClipThreshold);
+	}
+
+	void Scene::RenderSprites(const Vector<Mat4x4>& inverseViewProjections)
 	{
-		auto spritesGroup = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-		for (auto sp : spritesGroup)
+		auto& bounds = m_SpriteBounds;
+		bounds.Entities.clear();
+
+		if (m_RetainedSprites)
 		{
-			auto& sprite = spritesGroup.get<SpriteRendererComponent>(sp);
-			if (sprite.Enabled)
+			// Placeholders became master textures since the last frame
+			if (m_TextureLoadEpoch != TextureManager::GetLoadEpoch())
 			{
-				auto& sptransform = spritesGroup.get<TransformComponent>(sp);
+				m_TextureLoadEpoch = TextureManager::GetLoadEpoch();
+				m_ChangedSprites.insert(m_ChangedSprites.end(), m_LoadingSprites.begin(), m_LoadingSprites.end());
+				m_LoadingSprites.clear();
+			}
+
+			for (auto entity : m_ChangedSprites)
+				UpdateRetainedSprite(entity);
+			m_ChangedSprites.clear();
+
+			Renderer2D::DrawRetained(*m_RetainedSprites);
+
+			// Retained slots are already on the GPU, only the ones submitted every frame are culled
+			bounds.Entities.assign(m_ImmediateSprites.begin(), m_ImmediateSprites.end());
+		}
+		else
+		{
+			auto spritesGroup = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
+			for (auto sp : spritesGroup)
+			{
+				if (spritesGroup.get<SpriteRendererComponent>(sp).Enabled)
+					bounds.Entities.push_back(sp);
+			}
+		}
+
+		CullSprites(inverseViewProjections);
 
-				if (sprite.Sprite && sprite.Sprite->GetType() != TextureType::Placeholder)
+		for (size_t i = 0; i < bounds.Entities.size(); i++)
+		{
+			if (bounds.Visible[i])
+				SubmitSprite(m_Registry.get<SpriteRendererComponent>(bounds.Entities[i]), m_Registry.get<TransformComponent>(bounds.Entities[i]));
+		}
+	}
+
+	/**
+	 * AABB of the part of a camera frustum between minZ and maxZ (depth range of the sprites).
+	 * Much tighter than the bounds of the whole frustum for perspective cameras.
+	 * Returns false if the frustum doesn't reach that range.
+	 */
+	static bool CalculateViewBounds(const Mat4x4& inverseViewProjection, float minZ, float maxZ, Vector3& min, Vector3& max)
+	{
+		Vector3 corners[8];
+		for (int i = 0; i < 8; i++)
+		{
+			Vector4 corner = inverseViewProjection * Vector4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f);
+			corners[i] = Vector3(corner) / corner.w;
+		}
+
+		min = Vector3(std::numeric_limits<float>::max());
+		max = Vector3(std::numeric_limits<float>::lowest());
+		bool intersects = false;
+
+		// Every vertex of the clipped frustum lies on one of the 12 edges of the frustum
+		for (int i = 0; i < 8; i++)
+		{
+			for (int axis = 1; axis < 8; axis <<= 1)
+			{
+				if (i & axis)
+					continue;
+
+				const Vector3& a = corners[i];
+				const Vector3& b = corners[i | axis];
+
+				float t0 = 0.0f, t1 = 1.0f;
+				float dz = b.z - a.z;
+
+				if (std::abs(dz) < 1e-6f)
 				{
-					TexturedQuadExtraData data;
-					data.Tint = sprite.Tint;
-					data.Tiling = sprite.Tiling;
-					data.Offset = sprite.Offset;
-					data.Flip = sprite.Flip;
-					data.Wrapping = sprite.Wrapping;
-					data.Filtering = sprite.Filtering;
-					data.AlphaClipThreshold = sprite.AlphaClipThreshold;
-					data.TextureBorderColor = sprite.TextureBorderColor;
-
-					Renderer2D::DrawQuad(sptransform, sprite.Sprite, data);
+					if (a.z < minZ || a.z > maxZ)
+						continue;
 				}
 				else
 				{
-					Renderer2D::DrawQuad(sptransform, sprite.Tint, sprite.AlphaClipThreshold);
+					float tMin = (minZ - a.z) / dz;
+					float tMax = (maxZ - a.z) / dz;
+					if (tMin > tMax)
+						std::swap(tMin, tMax);
+
+					t0 = std::max(t0, tMin);
+					t1 = std::min(t1, tMax);
+					if (t0 > t1)
+						continue;
+				}
+
+				for (float t : { t0, t1 })
+				{
+					Vector3 point = a + t * (b - a);
+					min = glm::min(min, point);
+					max = glm::max(max, point);
 				}
+
+				intersects = true;
 			}
 		}
+
+		return intersects;
+	}
+
+	// Marks bounds.Visible of the sprites overlapping [viewMin, viewMax]
+	static void TestSpriteBounds(const Vector<float>& minX, const Vector<float>& minY, const Vector<float>& minZ,
+	                             const Vector<float>& maxX, const Vector<float>& maxY, const Vector<float>& maxZ,
+	                             const Vector3& viewMin, const Vector3& viewMax, Vector<uint8_t>& visible)
+	{
+		size_t count = visible.size();
+
+	#if OE_SCENE_CULLING_SSE
+		__m128 viewMinX = _mm_set1_ps(viewMin.x), viewMaxX = _mm_set1_ps(viewMax.x);
+		__m128 viewMinY = _mm_set1_ps(viewMin.y), viewMaxY = _mm_set1_ps(viewMax.y);
+		__m128 viewMinZ = _mm_set1_ps(viewMin.z), viewMaxZ = _mm_set1_ps(viewMax.z);
+
+		for (size_t i = 0; i < count; i += 4)
+		{
+			__m128 overlap = _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&maxX[i]), viewMinX), _mm_cmple_ps(_mm_loadu_ps(&minX[i]), viewMaxX));
+			overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&maxY[i]), viewMinY), _mm_cmple_ps(_mm_loadu_ps(&minY[i]), viewMaxY)));
+			overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&maxZ[i]), viewMinZ), _mm_cmple_ps(_mm_loadu_ps(&minZ[i]), viewMaxZ)));
+
+			int mask = _mm_movemask_ps(overlap);
+			visible[i    ] |= mask & 1;
+			visible[i + 1] |= (mask >> 1) & 1;
+			visible[i + 2] |= (mask >> 2) & 1;
+			visible[i + 3] |= (mask >> 3) & 1;
+		}
+	#else
+		for (size_t i = 0; i < count; i++)
+		{
+			visible[i] |= (uint8_t)(
+				(maxX[i] >= viewMin.x) & (minX[i] <= viewMax.x) &
+				(maxY[i] >= viewMin.y) & (minY[i] <= viewMax.y) &
+				(maxZ[i] >= viewMin.z) & (minZ[i] <= viewMax.z)
+			);
+		}
+	#endif
+	}
+
+	void Scene::CullSprites(const Vector<Mat4x4>& inverseViewProjections)
+	{
+		auto& bounds = m_SpriteBounds;
+
+		size_t count = bounds.Entities.size();
+		size_t paddedCount = (count + 3) & ~(size_t)3;
+
+		bool culling = !inverseViewProjections.empty();
+		bounds.Visible.assign(paddedCount, culling ? 0 : 1);
+
+		if (!culling || !count)
+		{
+			Renderer2D::GetStatistics().VisibleSpriteCount += (uint32_t)count;
+			return;
+		}
+
+		for (auto* array : { &bounds.MinX, &bounds.MinY, &bounds.MinZ, &bounds.MaxX, &bounds.MaxY, &bounds.MaxZ })
+			array->resize(paddedCount);
+
+		float spritesMinZ = std::numeric_limits<float>::max();
+		float spritesMaxZ = std::numeric_limits<float>::lowest();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Mat4x4& transform = m_Registry.get<TransformComponent>(bounds.Entities[i]).GetLocalToWorld();
+
+			// Unit quad on the local XY plane, see ExpandQuadCorners in Renderer2D
+			Vector3 center = transform[3];
+			Vector3 extents = 0.5f * (glm::abs(Vector3(transform[0])) + glm::abs(Vector3(transform[1])));
+
+			bounds.MinX[i] = center.x - extents.x;
+			bounds.MinY[i] = center.y - extents.y;
+			bounds.MinZ[i] = center.z - extents.z;
+			bounds.MaxX[i] = center.x + extents.x;
+			bounds.MaxY[i] = center.y + extents.y;
+			bounds.MaxZ[i] = center.z + extents.z;
+
+			spritesMinZ = std::min(spritesMinZ, bounds.MinZ[i]);
+			spritesMaxZ = std::max(spritesMaxZ, bounds.MaxZ[i]);
+		}
+
+		// Padding never overlaps anything
+		for (size_t i = count; i < paddedCount; i++)
+		{
+			bounds.MinX[i] = bounds.MinY[i] = bounds.MinZ[i] = std::numeric_limits<float>::max();
+			bounds.MaxX[i] = bounds.MaxY[i] = bounds.MaxZ[i] = std::numeric_limits<float>::lowest();
+		}
+
+		for (const auto& inverseViewProjection : inverseViewProjections)
+		{
+			Vector3 viewMin, viewMax;
+			if (CalculateViewBounds(inverseViewProjection, spritesMinZ, spritesMaxZ, viewMin, viewMax))
+				TestSpriteBounds(bounds.MinX, bounds.MinY, bounds.MinZ, bounds.MaxX, bounds.MaxY, bounds.MaxZ, viewMin, viewMax, bounds.Visible);
+		}
+
+		uint32_t visibleCount = 0;
+		for (size_t i = 0; i < count; i++)
+			visibleCount += bounds.Visible[i];
+
+		Renderer2D::GetStatistics().VisibleSpriteCount += visibleCount;
+		Renderer2D::GetStatistics().CulledSpriteCount += (uint32_t)count - visibleCount;
+	}
+
+	void Scene::SetRetainedSpriteRendering(bool enabled)
+	{
+		m_RetainedSpriteSlots.clear();
+		m_ImmediateSprites.clear();
+		m_ChangedSprites.clear();
+		m_LoadingSprites.clear();
+		m_RetainedSprites = nullptr;
+
+		if (!enabled)
+			return;
+
+		m_RetainedSprites = CreateScope<RetainedQuadBatch>();
+		m_TextureLoadEpoch = TextureManager::GetLoadEpoch();
+
+		m_Registry.view<TransformComponent>().each([](TransformComponent& tc) {
+			tc.m_ChangedFlags &= ~TransformComponent::ChangedFlags_Changed;
+		});
+
+		m_Registry.view<SpriteRendererComponent>().each([this](entt::entity entity, SpriteRendererComponent&) {
+			m_ChangedSprites.push_back(entity);
+		});
+	}
+
+	void Scene::MarkSpriteChanged(entt::entity entity)
+	{
+		if (m_RetainedSprites)
+			m_ChangedSprites.push_back(entity);
+	}
+
+	void Scene::OnSpriteConstructed(entt::registry& registry, entt::entity entity)
+	{
+		MarkSpriteChanged(entity);
+	}
+
+	void Scene::OnSpriteDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		if (!m_RetainedSprites)
+			return;
+
+		auto it = m_RetainedSpriteSlots.find(entity);
+		if (it != m_RetainedSpriteSlots.end())
+		{
+			RemoveImmediateSprite(it->second);
+			m_RetainedSprites->FreeSlot(it->second.Slot);
+			m_RetainedSpriteSlots.erase(it);
+		}
+	}
+
+	// Swap and pop, the moved sprite's index is updated through its slot entry
+	void Scene::RemoveImmediateSprite(RetainedSprite& sprite)
+	{
+		if (sprite.ImmediateIndex == UINT32_MAX)
+			return;
+
+		entt::entity moved = m_ImmediateSprites.back();
+		m_ImmediateSprites[sprite.ImmediateIndex] = moved;
+		m_RetainedSpriteSlots.at(moved).ImmediateIndex = sprite.ImmediateIndex;
+
+		m_ImmediateSprites.pop_back();
+		sprite.ImmediateIndex = UINT32_MAX;
+	}
+
+	// Rewrites the slot of entity, the only per sprite work of retained mode
+	void Scene::UpdateRetainedSprite(entt::entity entity)
+	{
+		if (!m_Registry.valid(entity))
+			return;
+
+		if (auto tc = m_Registry.try_get<TransformComponent>(entity))
+			tc->m_ChangedFlags &= ~TransformComponent::ChangedFlags_Changed;
+
+		auto sprite = m_Registry.try_get<SpriteRendererComponent>(entity);
+		if (!sprite)
+			return;
+
+		auto& transform = m_Registry.get<TransformComponent>(entity);
+
+		auto [it, inserted] = m_RetainedSpriteSlots.try_emplace(entity);
+		if (inserted)
+			it->second.Slot = m_RetainedSprites->AllocateSlot();
+
+		RetainedSprite& retainedSprite = it->second;
+		uint32_t slot = retainedSprite.Slot;
+
+		bool retained = true;
+		if (!sprite->Enabled)
+		{
+			m_RetainedSprites->HideQuad(slot);
+		}
+		else if (IsLoadingSprite(*sprite))
+		{
+			m_RetainedSprites->HideQuad(slot);
+			m_LoadingSprites.push_back(entity);
+		}
+		else if (IsTexturedSprite(*sprite))
+		{
+			retained = m_RetainedSprites->SetQuad(slot, transform, sprite->Sprite, GetSpriteExtraData(*sprite));
+		}
+		else
+		{
+			retained = m_RetainedSprites->SetQuad(slot, transform, sprite->Tint, sprite->AlphaClipThreshold);
+		}
+
+		if (retained)
+		{
+			RemoveImmediateSprite(retainedSprite);
+		}
+		else if (retainedSprite.ImmediateIndex == UINT32_MAX)
+		{
+			retainedSprite.ImmediateIndex = (uint32_t)m_ImmediateSprites.size();
+			m_ImmediateSprites.push_back(entity);
+		}
 	}
 
 	bool Scene::OnRender()
 	{
-		bool anyCamera = false;
-		
-		m_Registry.group<TransformComponent>(entt::get<CameraComponent>).each([&anyCamera, this](auto entity, auto& tc, auto& cc) {
+		auto camerasGroup = m_Registry.group<TransformComponent>(entt::get<CameraComponent>);
 
+		Vector<Mat4x4> inverseViewProjections;
+		camerasGroup.each([&inverseViewProjections](auto entity, auto& tc, auto& cc) {
 			if (cc.Enabled && tc.Enabled)
-			{
-				anyCamera = true;
+				inverseViewProjections.push_back(tc.GetLocalToWorld() * glm::inverse(cc.Camera.GetProjection()));
+		});
+
+		// Returns false if nothing is rendered
+		if (inverseViewProjections.empty())
+			return false;
+
+		// Sprites are built once in world space and drawn from every camera
+		Renderer2D::BeginGeometry();
+		RenderSprites(inverseViewProjections);
+		Renderer2D::EndGeometry();
 
+		camerasGroup.each([](auto entity, auto& tc, auto& cc) {
+
+			if (cc.Enabled && tc.Enabled)
+			{
 				RenderCommand::SetClearColor(cc.Camera.GetClearColor());
 				RenderCommand::Clear(cc.Camera.GetClearFlags());
 
-				Renderer2D::BeginScene(glm::inverse(tc.GetLocalToWorld()), cc.Camera);
-				RenderSprites();
-				Renderer2D::EndScene();
+				Renderer2D::DrawGeometry(glm::inverse(tc.GetLocalToWorld()), cc.Camera);
 			}
 
 		});
 
-		// Returns false if nothing is rendered
-		return anyCamera;
+		return true;
 	}
 
 	void Scene::SetViewportSize(uint32_t width, uint32_t height)
@@ -240,7 +593,7 @@ namespace OverEngine
 
 	void Scene::LoadReferences(AssetCollection& assetCollection)
 	{
-		m_Registry.view<SpriteRendererComponent>().each([&assetCollection](SpriteRendererComponent& sp) {
+		m_Registry.view<SpriteRendererComponent>().each([this, &assetCollection](entt::entity entity, SpriteRendererComponent& sp) {
 
 			if (sp.Sprite && sp.Sprite->GetType() == TextureType::Placeholder)
 			{
@@ -248,9 +601,11 @@ namespace OverEngine
 
 				auto asset = assetCollection.GetAsset(pl.AssetGuid);
 
-				if (asset->GetType() == AssetType::Texture2D)
+				// Placeholders of CreateMasterAsync have no asset
+				if (asset && asset->GetType() == AssetType::Texture2D)
 				{
 					sp.Sprite = asset->GetTexture2DAsset()->GetTextures()[pl.Texture2DGuid];
+					MarkSpriteChanged(entity);
 				}
 			}
 
@@ -12,6 +12,7 @@ namespace OverEngine
 	class SceneCamera;
 	class Entity;
 	class Scene;
+	class RetainedQuadBatch;
 
 	struct Physics2DSettings
 	{
@@ -56,9 +57,23 @@ namespace OverEngine
 
 		// Rendering
 		bool OnRender();
-		void RenderSprites();
+
+		/**
+		 * inverseViewProjections : camera to world * inverse(projection) of each camera which will draw the sprites.
+		 * Sprites outside of all of them are skipped, an empty list disables culling.
+		 */
+		void RenderSprites(const Vector<Mat4x4>& inverseViewProjections = {});
 		void SetViewportSize(uint32_t width, uint32_t height);
 
+		/**
+		 * In retained mode opaque sprites keep a slot in a GPU buffer and are only rewritten
+		 * when their transform changes or MarkSpriteChanged is called (after editing a SpriteRendererComponent).
+		 * Transparent sprites are still submitted every frame to be sorted.
+		 */
+		void SetRetainedSpriteRendering(bool enabled);
+		inline bool IsRetainedSpriteRendering() const { return (bool)m_RetainedSprites; }
+		void MarkSpriteChanged(entt::entity entity);
+
 		void LoadReferences(AssetCollection& assetCollection);
 
 		inline PhysicWorld2D& GetPhysicWorld2D() { return *m_PhysicWorld2D; }
@@ -70,6 +85,16 @@ namespace OverEngine
 		inline uint32_t GetEntityCount() const;
 
 		inline bool Exists(const entt::entity& entity) { return m_Registry.valid(entity); }
+	private:
+		void ConnectSignals();
+		void OnSpriteConstructed(entt::registry& registry, entt::entity entity);
+		void OnSpriteDestroyed(entt::registry& registry, entt::entity entity);
+
+		void UpdateRetainedSprite(entt::entity entity);
+		struct RetainedSprite;
+		void RemoveImmediateSprite(RetainedSprite& sprite);
+
+		void CullSprites(const Vector<Mat4x4>& inverseViewProjections);
 	private:
 		entt::registry m_Registry;
 		PhysicWorld2D* m_PhysicWorld2D = nullptr;
@@ -83,6 +108,29 @@ namespace OverEngine
 		Vector<entt::entity> m_RootHandles;
 		UnorderedMap<entt::entity, Vector<entt::id_type>> m_ComponentList;
 
+		// Retained sprite rendering
+		Scope<RetainedQuadBatch> m_RetainedSprites;
+
+		struct RetainedSprite
+		{
+			uint32_t Slot = 0;
+			uint32_t ImmediateIndex = UINT32_MAX; // In m_ImmediateSprites, UINT32_MAX while drawn from its slot
+		};
+		UnorderedMap<entt::entity, RetainedSprite> m_RetainedSpriteSlots;
+		Vector<entt::entity> m_ImmediateSprites; // Transparent sprites, submitted every frame
+		Vector<entt::entity> m_ChangedSprites;
+		Vector<entt::entity> m_LoadingSprites; // Hidden until their placeholder texture is loaded
+		uint32_t m_TextureLoadEpoch = 0;
+
+		// World space AABBs of the sprites being culled, one array per component so they can be tested 4 at a time
+		struct SpriteBounds
+		{
+			Vector<entt::entity> Entities;
+			Vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+			Vector<uint8_t> Visible;
+		};
+		SpriteBounds m_SpriteBounds;
+
 		friend class Entity;
 		friend class SceneSerializer;
 	};
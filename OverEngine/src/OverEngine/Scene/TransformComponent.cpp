@@ -1,5 +1,6 @@
 #include "pcheader.h"
 #include "TransformComponent.h"
+#include "Scene.h"
 
 namespace OverEngine
 {
@@ -250,6 +251,10 @@ namespace OverEngine
 	// Add changed flag and force all children to update
 	void TransformComponent::Change()
 	{
+		// Retained sprites are only rewritten when their transform changed
+		if (!(m_ChangedFlags & ChangedFlags_Changed) && AttachedEntity.GetScene())
+			AttachedEntity.GetScene()->MarkSpriteChanged(AttachedEntity);
+
 		m_ChangedFlags |= ChangedFlags_Changed | ChangedFlags_ChangedForPhysics;
 
 		for (const auto& child : m_Children)
@@ -0,0 +1,51 @@
+#include "pcheader.h"
+#include "OverEngine/Core/FileSystem/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OverEngine
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const String& path)
+	{
+		Close();
+
+		int file = open(path.c_str(), O_RDONLY);
+		if (file == -1)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) == -1 || status.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		// The mapping keeps the file referenced on its own
+		void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Data = (const uint8_t*)data;
+		m_Size = (size_t)status.st_size;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+			munmap((void*)m_Data, m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+}
@@ -0,0 +1,218 @@
+#include "pcheader.h"
+#include "NullBuffer.h"
+
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	/////////////////////////////////////////////////////////////////////////////
+	// VertexBuffer /////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullVertexBuffer::NullVertexBuffer()
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const float* vertices, uint32_t size, bool staticDraw)
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+		BufferData(vertices, size, staticDraw);
+	}
+
+	void NullVertexBuffer::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID);
+	}
+
+	void NullVertexBuffer::Unbind() const
+	{
+	}
+
+	void NullVertexBuffer::BufferData(const float* vertices, uint32_t size, bool staticDraw) const
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, vertices ? size : 0, 0, size);
+	}
+
+	void NullVertexBuffer::BufferSubData(const float* vertices, uint32_t size, uint32_t offset) const
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, size, offset);
+	}
+
+	void NullVertexBuffer::AllocateStorage(uint32_t size) const
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, 0, 0, size);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// IndexBuffer //////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullIndexBuffer::NullIndexBuffer()
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const uint32_t* indices, uint32_t count, bool staticDraw)
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+		BufferData(indices, count, staticDraw);
+	}
+
+	void NullIndexBuffer::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID);
+	}
+
+	void NullIndexBuffer::Unbind() const
+	{
+	}
+
+	void NullIndexBuffer::BufferData(const uint32_t* indices, uint32_t count, bool staticDraw) const
+	{
+		m_Count = count;
+		uint32_t size = count * sizeof(uint32_t);
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, indices ? size : 0, 0, size);
+	}
+
+	void NullIndexBuffer::BufferSubData(const uint32_t* indices, uint32_t count, uint32_t offset) const
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, count * sizeof(uint32_t), offset * sizeof(uint32_t));
+	}
+
+	void NullIndexBuffer::AllocateStorage(uint32_t count) const
+	{
+		m_Count = count;
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, 0, 0, count * sizeof(uint32_t));
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// StreamingBuffer //////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullStreamingBuffer::NullStreamingBuffer(uint32_t regionSize, uint32_t regionCount)
+		: m_RendererID(NullRecorder::GenRendererID()), m_RegionSize(regionSize), m_RegionCount(regionCount),
+		m_Data((size_t)regionSize * regionCount)
+	{
+		OE_CORE_ASSERT(regionSize && regionCount, "StreamingBuffer must have at least one non-empty region!");
+	}
+
+	void NullStreamingBuffer::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID);
+	}
+
+	void NullStreamingBuffer::Unbind() const
+	{
+	}
+
+	void* NullStreamingBuffer::Map(uint32_t size, uint32_t alignment)
+	{
+		OE_CORE_ASSERT(size <= m_RegionSize, "StreamingBuffer region is too small!");
+
+		uint32_t offset = (m_Head + alignment - 1) / alignment * alignment;
+		if (offset + size > (uint32_t)m_Data.size())
+			offset = 0;
+
+		m_MappedOffset = offset;
+		m_MappedSize = size;
+		m_Head = offset + size;
+		return m_Data.data() + offset;
+	}
+
+	void NullStreamingBuffer::Unmap()
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, m_MappedSize, m_MappedOffset);
+		m_MappedSize = 0;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// PixelUnpackBuffer ////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullPixelUnpackBuffer::NullPixelUnpackBuffer(uint32_t regionSize, uint32_t regionCount)
+		: m_RendererID(NullRecorder::GenRendererID()), m_RegionSize(regionSize), m_RegionCount(regionCount),
+		m_Data((size_t)regionSize * regionCount)
+	{
+		OE_CORE_ASSERT(regionSize && regionCount, "PixelUnpackBuffer must have at least one non-empty region!");
+	}
+
+	void NullPixelUnpackBuffer::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID);
+	}
+
+	void NullPixelUnpackBuffer::Unbind() const
+	{
+	}
+
+	void NullPixelUnpackBuffer::NextRegion()
+	{
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+		m_Head = m_CurrentRegion * m_RegionSize;
+	}
+
+	void* NullPixelUnpackBuffer::Map(uint32_t size)
+	{
+		uint32_t offset = (m_Head + 3) / 4 * 4;
+		if (offset + size > (m_CurrentRegion + 1) * m_RegionSize)
+			return nullptr;
+
+		m_MappedOffset = offset;
+		m_MappedSize = size;
+		m_Head = offset + size;
+		return m_Data.data() + offset;
+	}
+
+	void NullPixelUnpackBuffer::Unmap()
+	{
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, m_MappedSize, m_MappedOffset);
+		m_MappedSize = 0;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// ShaderStorageBuffer //////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullShaderStorageBuffer::NullShaderStorageBuffer()
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+	}
+
+	void NullShaderStorageBuffer::Bind(uint32_t binding) const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID, binding);
+	}
+
+	void NullShaderStorageBuffer::BufferSubData(const void* data, uint32_t size, uint32_t offset) const
+	{
+		OE_CORE_ASSERT(offset + size <= m_Size, "ShaderStorageBuffer overflow!");
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, size, offset);
+	}
+
+	void NullShaderStorageBuffer::AllocateStorage(uint32_t size) const
+	{
+		m_Size = size;
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, 0, 0, size);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// UniformBuffer ////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullUniformBuffer::NullUniformBuffer(uint32_t size)
+		: m_RendererID(NullRecorder::GenRendererID()), m_Size(size)
+	{
+	}
+
+	void NullUniformBuffer::Bind(uint32_t binding) const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID, binding);
+	}
+
+	void NullUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset) const
+	{
+		OE_CORE_ASSERT(offset + size <= m_Size, "UniformBuffer overflow!");
+		NullRecorder::Record(NullCommandType::UploadBuffer, m_RendererID, size, offset);
+	}
+}
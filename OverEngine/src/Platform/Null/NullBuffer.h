@@ -0,0 +1,144 @@
+#pragma once
+
+#include "OverEngine/Renderer/Buffer.h"
+
+namespace OverEngine
+{
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer();
+		NullVertexBuffer(const float* vertices, uint32_t size, bool staticDraw);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void BufferData(const float* vertices, uint32_t size, bool staticDraw = true) const override;
+		virtual void BufferSubData(const float* vertices, uint32_t size, uint32_t offset = 0) const override;
+		virtual void AllocateStorage(uint32_t size) const override;
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		uint32_t m_RendererID;
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer();
+		NullIndexBuffer(const uint32_t* indices, uint32_t count, bool staticDraw);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void BufferData(const uint32_t* indices, uint32_t count, bool staticDraw = true) const override;
+		virtual void BufferSubData(const uint32_t* indices, uint32_t count, uint32_t offset = 0) const override;
+		virtual void AllocateStorage(uint32_t count) const override;
+
+		virtual uint32_t GetCount() const { return m_Count; }
+	private:
+		uint32_t m_RendererID;
+		mutable uint32_t m_Count = 0;
+	};
+
+	/**
+	 * Map returns CPU memory so the writer does the same work as with a real mapping,
+	 * regions are reused in a ring without any fencing.
+	 */
+	class NullStreamingBuffer : public StreamingBuffer
+	{
+	public:
+		NullStreamingBuffer(uint32_t regionSize, uint32_t regionCount);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void* Map(uint32_t size, uint32_t alignment = 1) override;
+		virtual void Unmap() override;
+
+		virtual uint32_t GetMappedOffset() const override { return m_MappedOffset; }
+
+		virtual uint32_t GetRegionSize() const override { return m_RegionSize; }
+		virtual uint32_t GetRegionCount() const override { return m_RegionCount; }
+		virtual bool IsPersistentlyMapped() const override { return true; }
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		uint32_t m_RendererID;
+		BufferLayout m_Layout;
+
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+
+		uint32_t m_Head = 0;
+		uint32_t m_MappedOffset = 0;
+		uint32_t m_MappedSize = 0;
+
+		Vector<uint8_t> m_Data;
+	};
+
+	class NullPixelUnpackBuffer : public PixelUnpackBuffer
+	{
+	public:
+		NullPixelUnpackBuffer(uint32_t regionSize, uint32_t regionCount);
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void* Map(uint32_t size) override;
+		virtual void Unmap() override;
+
+		virtual uint32_t GetMappedOffset() const override { return m_MappedOffset; }
+
+		virtual void NextRegion() override;
+
+		virtual uint32_t GetRegionSize() const override { return m_RegionSize; }
+		virtual uint32_t GetRegionCount() const override { return m_RegionCount; }
+	private:
+		uint32_t m_RendererID;
+
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+
+		uint32_t m_CurrentRegion = 0;
+		uint32_t m_Head = 0;
+		uint32_t m_MappedOffset = 0;
+		uint32_t m_MappedSize = 0;
+
+		Vector<uint8_t> m_Data;
+	};
+
+	class NullShaderStorageBuffer : public ShaderStorageBuffer
+	{
+	public:
+		NullShaderStorageBuffer();
+
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual void BufferSubData(const void* data, uint32_t size, uint32_t offset = 0) const override;
+		virtual void AllocateStorage(uint32_t size) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_RendererID;
+		mutable uint32_t m_Size = 0;
+	};
+
+	class NullUniformBuffer : public UniformBuffer
+	{
+	public:
+		NullUniformBuffer(uint32_t size);
+
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_Size;
+	};
+}
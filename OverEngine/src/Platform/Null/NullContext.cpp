@@ -0,0 +1,39 @@
+#include "pcheader.h"
+#include "NullContext.h"
+
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	NullContext::NullContext(Window* window)
+	{
+	}
+
+	void NullContext::Init()
+	{
+	}
+
+	void NullContext::SwapBuffers()
+	{
+		NullRecorder::Record(NullCommandType::SwapBuffers);
+	}
+
+	void NullContext::Current()
+	{
+	}
+
+	const char* NullContext::GetInfoVersion()
+	{
+		return "Null";
+	}
+
+	const char* NullContext::GetInfoVendor()
+	{
+		return "OverEngine";
+	}
+
+	const char* NullContext::GetInfoRenderer()
+	{
+		return "Null Renderer";
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "OverEngine/Renderer/RendererContext.h"
+
+namespace OverEngine
+{
+	class NullContext : public RendererContext
+	{
+	public:
+		NullContext(Window* window);
+
+		virtual void Init() override;
+		virtual void SwapBuffers() override;
+
+		virtual void Current() override;
+
+		virtual const char* GetInfoVersion()  override;
+		virtual const char* GetInfoVendor()   override;
+		virtual const char* GetInfoRenderer() override;
+	};
+}
@@ -0,0 +1,29 @@
+#include "pcheader.h"
+#include "NullFrameBuffer.h"
+
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	NullFrameBuffer::NullFrameBuffer(const FrameBufferProps& props)
+		: m_RendererID(NullRecorder::GenRendererID()), m_ColorAttachment(NullRecorder::GenRendererID()), m_Props(props)
+	{
+	}
+
+	void NullFrameBuffer::Bind()
+	{
+		NullRecorder::Record(NullCommandType::BindFrameBuffer, m_RendererID);
+		NullRecorder::Record(NullCommandType::SetViewport, 0, m_Props.Width, m_Props.Height);
+	}
+
+	void NullFrameBuffer::Unbind()
+	{
+		NullRecorder::Record(NullCommandType::BindFrameBuffer, 0);
+	}
+
+	void NullFrameBuffer::Resize(uint32_t width, uint32_t height)
+	{
+		m_Props.Width = width;
+		m_Props.Height = height;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "OverEngine/Renderer/FrameBuffer.h"
+
+namespace OverEngine
+{
+	class NullFrameBuffer : public FrameBuffer
+	{
+	public:
+		NullFrameBuffer(const FrameBufferProps& props);
+
+		virtual void Bind() override;
+		virtual void Unbind() override;
+
+		virtual void Resize(uint32_t width, uint32_t height) override;
+
+		virtual uint32_t GetColorAttachmentRendererID() const override { return m_ColorAttachment; }
+
+		virtual const FrameBufferProps& GetProps() const override { return m_Props; }
+	private:
+		uint32_t m_RendererID;
+		uint32_t m_ColorAttachment;
+		FrameBufferProps m_Props;
+	};
+}
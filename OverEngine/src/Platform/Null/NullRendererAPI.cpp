@@ -0,0 +1,136 @@
+#include "pcheader.h"
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	/////////////////////////////////////////////////////////////////////////////
+	// NullRecorder /////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	NullStatistics NullRecorder::s_Statistics;
+	Vector<NullCommand> NullRecorder::s_Commands;
+	bool NullRecorder::s_Recording = false;
+	uint32_t NullRecorder::s_LastRendererID = 0;
+
+	void NullRecorder::Record(NullCommandType type, uint32_t object, uint32_t arg0, uint32_t arg1, uint32_t arg2)
+	{
+		switch (type)
+		{
+		case NullCommandType::Clear:
+			s_Statistics.Clears++;
+			break;
+		case NullCommandType::DrawIndexed:
+			s_Statistics.DrawCalls++;
+			s_Statistics.IndexCount += arg0;
+			break;
+		case NullCommandType::DrawInstanced:
+			s_Statistics.DrawCalls++;
+			s_Statistics.VertexCount += arg0 * arg1;
+			s_Statistics.InstanceCount += arg1;
+			break;
+		case NullCommandType::BindBuffer:
+		case NullCommandType::BindTexture:
+		case NullCommandType::BindShader:
+		case NullCommandType::BindFrameBuffer:
+			s_Statistics.Binds++;
+			break;
+		case NullCommandType::UploadBuffer:
+			s_Statistics.BufferBytes += arg0;
+			break;
+		case NullCommandType::UploadTexture:
+			s_Statistics.TextureBytes += arg0;
+			break;
+		case NullCommandType::UploadUniform:
+			s_Statistics.UniformUploads++;
+			break;
+		case NullCommandType::SwapBuffers:
+			s_Statistics.Frames++;
+			break;
+		default:
+			break;
+		}
+
+		if (s_Recording)
+			s_Commands.push_back({ type, object, { arg0, arg1, arg2 } });
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// NullRendererAPI //////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	// Defaults to the GL 4.5 minimums, so batching behaves like on a real GPU
+	uint32_t NullRendererAPI::s_MaxTextureSize = 16384;
+	uint32_t NullRendererAPI::s_MaxTextureSlotCount = 16;
+	uint32_t NullRendererAPI::s_MaxArrayTextureLayers = 2048;
+
+	void NullRendererAPI::Init()
+	{
+		OE_CORE_INFO("Using Null renderer, nothing will be drawn");
+	}
+
+	void NullRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		NullRecorder::Record(NullCommandType::SetViewport, 0, width, height);
+	}
+
+	void NullRendererAPI::SetClearColor(const Math::Color& color)
+	{
+	}
+
+	void NullRendererAPI::SetClearDepth(float depth)
+	{
+	}
+
+	void NullRendererAPI::Clear(const ClearFlags& flags)
+	{
+		NullRecorder::Record(NullCommandType::Clear, 0, (uint32_t)flags);
+	}
+
+	void NullRendererAPI::SetBlendMode(BlendMode mode)
+	{
+		NullRecorder::Record(NullCommandType::SetBlendMode, 0, (uint32_t)mode);
+	}
+
+	void NullRendererAPI::BeginSampleCount()
+	{
+	}
+
+	uint64_t NullRendererAPI::EndSampleCount()
+	{
+		// Nothing is rasterized
+		return 0;
+	}
+
+	void NullRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		NullRecorder::Record(NullCommandType::DrawIndexed, 0, count, baseVertex);
+	}
+
+	void NullRendererAPI::DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		NullRecorder::Record(NullCommandType::DrawInstanced, 0, vertexCount, instanceCount, baseInstance);
+	}
+
+	uint32_t NullRendererAPI::GetMaxTextureSize()
+	{
+		return s_MaxTextureSize;
+	}
+
+	uint32_t NullRendererAPI::GetMaxTextureSlotCount()
+	{
+		return s_MaxTextureSlotCount;
+	}
+
+	uint32_t NullRendererAPI::GetMaxArrayTextureLayers()
+	{
+		return s_MaxArrayTextureLayers;
+	}
+
+	void NullRendererAPI::SetLimits(uint32_t maxTextureSize, uint32_t maxTextureSlotCount, uint32_t maxArrayTextureLayers /*= 2048*/)
+	{
+		s_MaxTextureSize = maxTextureSize;
+		s_MaxTextureSlotCount = maxTextureSlotCount;
+		s_MaxArrayTextureLayers = maxArrayTextureLayers;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "OverEngine/Renderer/RendererAPI.h"
+
+namespace OverEngine
+{
+	enum class NullCommandType : uint8_t
+	{
+		SetViewport, Clear,
+		DrawIndexed, DrawInstanced,
+		BindBuffer, UploadBuffer,
+		BindTexture, UploadTexture,
+		BindShader, UploadUniform,
+		BindFrameBuffer, SwapBuffers,
+		SetBlendMode
+	};
+
+	/**
+	 * Object is the renderer ID of the buffer / texture / shader the command targets (0 if none),
+	 * meaning of Args depends on the command type (sizes, counts, offsets).
+	 */
+	struct NullCommand
+	{
+		NullCommandType Type;
+		uint32_t Object;
+		uint32_t Args[3];
+	};
+
+	struct NullStatistics
+	{
+		uint32_t DrawCalls = 0;
+		uint32_t IndexCount = 0;
+		uint32_t VertexCount = 0;
+		uint32_t InstanceCount = 0;
+
+		uint32_t Binds = 0;
+		uint32_t UniformUploads = 0;
+		uint32_t Clears = 0;
+		uint32_t Frames = 0;
+
+		uint64_t BufferBytes = 0;
+		uint64_t TextureBytes = 0;
+	};
+
+	/**
+	 * Shared sink of every Null* object, counts what the GPU would have done
+	 * and, when recording is enabled, keeps a log of the commands.
+	 */
+	class NullRecorder
+	{
+	public:
+		static void Record(NullCommandType type, uint32_t object = 0, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0);
+
+		static NullStatistics& GetStatistics() { return s_Statistics; }
+		static void ResetStatistics() { s_Statistics = NullStatistics(); }
+
+		static void SetRecording(bool recording) { s_Recording = recording; }
+		static bool IsRecording() { return s_Recording; }
+
+		static const Vector<NullCommand>& GetCommands() { return s_Commands; }
+		static void ClearCommands() { s_Commands.clear(); }
+
+		static uint32_t GenRendererID() { return ++s_LastRendererID; }
+	private:
+		static NullStatistics s_Statistics;
+		static Vector<NullCommand> s_Commands;
+		static bool s_Recording;
+		static uint32_t s_LastRendererID;
+	};
+
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override;
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		virtual void SetClearColor(const Math::Color& color) override;
+		virtual void SetClearDepth(float depth) override;
+		virtual void Clear(const ClearFlags& flags) override;
+
+		virtual void SetBlendMode(BlendMode mode) override;
+
+		virtual void BeginSampleCount() override;
+		virtual uint64_t EndSampleCount() override;
+
+		// Nothing runs on a GPU
+		virtual void NextGPUTimerFrame() override {}
+		virtual void BeginGPUTimer(uint32_t view) override {}
+		virtual void EndGPUTimer() override {}
+		virtual uint64_t GetGPUFrameTime() override { return 0; }
+		virtual uint64_t GetGPUViewTime(uint32_t view) override { return 0; }
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance = 0) override;
+
+		virtual uint32_t GetMaxTextureSize() override;
+		virtual uint32_t GetMaxTextureSlotCount() override;
+		virtual uint32_t GetMaxArrayTextureLayers() override;
+
+		// Nothing is cached, every call is recorded
+		virtual uint32_t GetElidedCallCount() override { return 0; }
+
+		// Emulates the limits of another GPU, must be called before Renderer::Init
+		static void SetLimits(uint32_t maxTextureSize, uint32_t maxTextureSlotCount, uint32_t maxArrayTextureLayers = 2048);
+	private:
+		static uint32_t s_MaxTextureSize;
+		static uint32_t s_MaxTextureSlotCount;
+		static uint32_t s_MaxArrayTextureLayers;
+	};
+}
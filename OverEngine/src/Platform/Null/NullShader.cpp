@@ -0,0 +1,79 @@
+#include "pcheader.h"
+#include "NullShader.h"
+
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	NullShader::NullShader(const String& name, const String& filePath)
+		: m_RendererID(NullRecorder::GenRendererID()), m_Name(name), m_FilePath(filePath)
+	{
+		if (!m_Name.empty())
+			return;
+
+		auto lastSlash = filePath.find_last_of("/\\");
+		lastSlash = lastSlash == String::npos ? 0 : lastSlash + 1;
+		auto lastDot = filePath.rfind('.');
+		auto count = lastDot == String::npos ? filePath.size() - lastSlash : lastDot - lastSlash;
+		m_Name = filePath.substr(lastSlash, count);
+	}
+
+	void NullShader::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindShader, m_RendererID);
+	}
+
+	void NullShader::Unbind() const
+	{
+	}
+
+	void NullShader::UploadUniformInt(const char* name, int value)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(int));
+	}
+
+	void NullShader::UploadUniformIntArray(const char* name, const int* value, int count)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, count * sizeof(int));
+	}
+
+	void NullShader::UploadUniformFloat(const char* name, float value)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(float));
+	}
+
+	void NullShader::UploadUniformFloat2(const char* name, const Math::Vector2& value)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(Math::Vector2));
+	}
+
+	void NullShader::UploadUniformFloat3(const char* name, const Math::Vector3& value)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(Math::Vector3));
+	}
+
+	void NullShader::UploadUniformFloat4(const char* name, const Math::Vector4& value)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(Math::Vector4));
+	}
+
+	void NullShader::UploadUniformMat3(const char* name, const Math::Mat3x3& matrix)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(Math::Mat3x3));
+	}
+
+	void NullShader::UploadUniformMat4(const char* name, const Math::Mat4x4& matrix)
+	{
+		NullRecorder::Record(NullCommandType::UploadUniform, m_RendererID, sizeof(Math::Mat4x4));
+	}
+
+	bool NullShader::Reload(String filePath)
+	{
+		return !filePath.empty() || !m_FilePath.empty();
+	}
+
+	NullIntermediateShader::NullIntermediateShader()
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+	}
+}
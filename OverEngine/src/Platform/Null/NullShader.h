@@ -0,0 +1,47 @@
+#pragma once
+
+#include "OverEngine/Renderer/Shader.h"
+
+namespace OverEngine
+{
+	class NullShader : public Shader
+	{
+	public:
+		// Name is taken from filePath when empty
+		NullShader(const String& name, const String& filePath = String());
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual const String& GetName() const override { return m_Name; }
+
+		virtual void UploadUniformInt(const char* name, int value) override;
+		virtual void UploadUniformIntArray(const char* name, const int* value, int count) override;
+
+		virtual void UploadUniformFloat(const char* name, float value) override;
+		virtual void UploadUniformFloat2(const char* name, const Math::Vector2& value) override;
+		virtual void UploadUniformFloat3(const char* name, const Math::Vector3& value) override;
+		virtual void UploadUniformFloat4(const char* name, const Math::Vector4& value) override;
+
+		virtual void UploadUniformMat3(const char* name, const Math::Mat3x3& matrix) override;
+		virtual void UploadUniformMat4(const char* name, const Math::Mat4x4& matrix) override;
+
+		virtual bool Reload(String filePath = String()) override;
+		virtual bool Reload(const String& vertexSrc, const String& fragmentSrc) override { return true; }
+		virtual bool Reload(const char* vertexSrc, const char* fragmentSrc) override { return true; }
+	private:
+		uint32_t m_RendererID;
+		String m_Name;
+		String m_FilePath;
+	};
+
+	class NullIntermediateShader : public IntermediateShader
+	{
+	public:
+		NullIntermediateShader();
+
+		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+	private:
+		uint32_t m_RendererID;
+	};
+}
@@ -0,0 +1,121 @@
+#include "pcheader.h"
+#include "NullTexture.h"
+
+#include "NullRendererAPI.h"
+#include "OverEngine/Renderer/Buffer.h"
+
+#include <stb_image.h>
+
+namespace OverEngine
+{
+	namespace GAPI
+	{
+		static uint32_t GetBytesPerPixel(TextureFormat format)
+		{
+			switch (format)
+			{
+			case TextureFormat::RGB:  return 3;
+			case TextureFormat::RGBA: return 4;
+			default: return 0;
+			}
+		}
+
+		// Only reads the image header, pixels never leave the disk
+		NullTexture2D::NullTexture2D(const String& path, TextureFiltering minFilter, TextureFiltering magFilter)
+			: m_Width(0), m_Height(0), m_MinFilter(minFilter), m_MagFilter(magFilter),
+			m_SWrapping(TextureWrapping::Repeat), m_TWrapping(TextureWrapping::Repeat),
+			m_BorderColor(1.0f), m_Format(TextureFormat::None), m_RendererID(NullRecorder::GenRendererID())
+		{
+			int width, height, channels;
+			int success = stbi_info(path.c_str(), &width, &height, &channels);
+			OE_CORE_ASSERT(success, "Failde to load image!");
+			OE_CORE_ASSERT(channels == 3 || channels == 4, "Unsupported image format");
+
+			m_Width = width;
+			m_Height = height;
+			m_Format = channels == 4 ? TextureFormat::RGBA : TextureFormat::RGB;
+
+			NullRecorder::Record(NullCommandType::UploadTexture, m_RendererID, m_Width * m_Height * channels, m_Width, m_Height);
+		}
+
+		NullTexture2D::NullTexture2D()
+			: m_Width(0), m_Height(0),
+			m_MinFilter(TextureFiltering::Linear), m_MagFilter(TextureFiltering::Linear),
+			m_SWrapping(TextureWrapping::Repeat), m_TWrapping(TextureWrapping::Repeat),
+			m_BorderColor(1.0f), m_Format(TextureFormat::None), m_RendererID(NullRecorder::GenRendererID())
+		{
+		}
+
+		void NullTexture2D::Bind(uint32_t slot /*= 0*/) const
+		{
+			NullRecorder::Record(NullCommandType::BindTexture, m_RendererID, slot);
+		}
+
+		void NullTexture2D::AllocateStorage(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels /*= 1*/)
+		{
+			m_Width = width;
+			m_Height = height;
+			m_Format = format;
+			m_MipLevels = std::max(mipLevels, 1u);
+		}
+
+		void NullTexture2D::SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset /*= 0*/, int yOffset /*= 0*/, uint32_t level /*= 0*/)
+		{
+			OE_CORE_ASSERT(level < m_MipLevels, "Texture has no such mip level!");
+			OE_CORE_ASSERT((uint32_t)xOffset + width <= std::max(m_Width >> level, 1u) && (uint32_t)yOffset + height <= std::max(m_Height >> level, 1u), "SubImage is out of the texture bounds!");
+
+			m_Format = dataFormat;
+			NullRecorder::Record(NullCommandType::UploadTexture, m_RendererID, width * height * GetBytesPerPixel(dataFormat), width, height);
+		}
+
+		void NullTexture2D::SubImage(const PixelUnpackBuffer& buffer, uint32_t offset, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset /*= 0*/, int yOffset /*= 0*/)
+		{
+			buffer.Bind();
+			SubImage(nullptr, width, height, dataFormat, xOffset, yOffset);
+		}
+
+		void NullTexture2D::CopySubImage(const Texture2D& source, int sourceX, int sourceY, uint32_t width, uint32_t height, int xOffset /*= 0*/, int yOffset /*= 0*/)
+		{
+			OE_CORE_ASSERT((uint32_t)sourceX + width <= source.GetWidth() && (uint32_t)sourceY + height <= source.GetHeight(), "CopySubImage is out of the source bounds!");
+			OE_CORE_ASSERT((uint32_t)xOffset + width <= m_Width && (uint32_t)yOffset + height <= m_Height, "CopySubImage is out of the texture bounds!");
+		}
+
+		void NullTexture2D::GenerateMipmaps()
+		{
+		}
+
+		NullTexture2DArray::NullTexture2DArray(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels)
+			: m_Width(width), m_Height(height),
+			m_MinFilter(TextureFiltering::Linear), m_MagFilter(TextureFiltering::Linear),
+			m_SWrapping(TextureWrapping::Repeat), m_TWrapping(TextureWrapping::Repeat),
+			m_BorderColor(1.0f), m_Format(format), m_MipLevels(std::max(mipLevels, 1u)), m_RendererID(NullRecorder::GenRendererID())
+		{
+		}
+
+		void NullTexture2DArray::Bind(uint32_t slot /*= 0*/) const
+		{
+			NullRecorder::Record(NullCommandType::BindTexture, m_RendererID, slot);
+		}
+
+		void NullTexture2DArray::SetLayerCount(uint32_t layerCount)
+		{
+			uint32_t keptLayers = std::min(layerCount, (uint32_t)m_Layers.size());
+
+			// The kept layers are copied to the new storage
+			if (keptLayers)
+				NullRecorder::Record(NullCommandType::UploadTexture, m_RendererID, m_Width * m_Height * GetBytesPerPixel(m_Format) * keptLayers, m_Width, m_Height);
+
+			m_Layers.resize(layerCount);
+			for (uint32_t layer = keptLayers; layer < layerCount; layer++)
+			{
+				auto view = CreateRef<NullTexture2D>();
+				view->m_Width = m_Width;
+				view->m_Height = m_Height;
+				view->m_Format = m_Format;
+				view->m_MipLevels = m_MipLevels;
+				view->m_ArrayLayer = (int)layer;
+				m_Layers[layer] = view;
+			}
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "OverEngine/Renderer/Texture.h"
+
+namespace OverEngine
+{
+	namespace GAPI
+	{
+		class NullTexture2D : public Texture2D
+		{
+		public:
+			NullTexture2D(const String& path, TextureFiltering minFilter, TextureFiltering magFilter);
+			NullTexture2D();
+
+			inline virtual uint32_t GetWidth() const override { return m_Width; }
+			inline virtual uint32_t GetHeight() const override { return m_Height; }
+
+			inline virtual TextureWrapping GetSWrapping() const override { return m_SWrapping; }
+			inline virtual TextureWrapping GetTWrapping() const override { return m_TWrapping; }
+			inline virtual const Color& GetBorderColor() const override { return m_BorderColor; }
+
+			inline virtual void SetSWrapping(TextureWrapping wrapping) override { m_SWrapping = wrapping; }
+			inline virtual void SetTWrapping(TextureWrapping wrapping) override { m_TWrapping = wrapping; }
+			inline virtual void SetBorderColor(const Color& color) override { m_BorderColor = color; }
+
+			inline virtual TextureFiltering GetMinFilter() const override { return m_MinFilter; };
+			inline virtual TextureFiltering GetMagFilter() const override { return m_MagFilter; };
+
+			inline virtual void SetMinFilter(TextureFiltering filter) override { m_MinFilter = filter; }
+			inline virtual void SetMagFilter(TextureFiltering filter) override { m_MagFilter = filter; }
+
+			inline virtual TextureFormat GetFormat() const override { return m_Format; }
+
+			virtual void Bind(uint32_t slot = 0) const override;
+			inline virtual uint32_t GetRendererID() const { return m_RendererID; }
+
+			inline virtual bool operator==(const Texture& other) const override
+			{
+				return m_RendererID == other.GetRendererID();
+			}
+
+			virtual void AllocateStorage(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels = 1) override;
+			virtual void SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0, uint32_t level = 0) override;
+			virtual void SubImage(const PixelUnpackBuffer& buffer, uint32_t offset, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0) override;
+			virtual void CopySubImage(const Texture2D& source, int sourceX, int sourceY, uint32_t width, uint32_t height, int xOffset = 0, int yOffset = 0) override;
+
+			virtual void GenerateMipmaps() override;
+			inline virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+
+			inline virtual int GetArrayLayer() const override { return m_ArrayLayer; }
+
+			inline virtual Vector<::OverEngine::Texture2D*>& GetMemberTextures() override { return m_Members; }
+		private:
+			friend class NullTexture2DArray;
+		private:
+			uint32_t m_Width, m_Height;
+			TextureFiltering m_MinFilter, m_MagFilter;
+			TextureWrapping m_SWrapping, m_TWrapping;
+			Color m_BorderColor;
+			TextureFormat m_Format;
+			uint32_t m_MipLevels = 1;
+			uint32_t m_RendererID;
+			int m_ArrayLayer = -1;
+			Vector<::OverEngine::Texture2D*> m_Members;
+		};
+
+		class NullTexture2DArray : public Texture2DArray
+		{
+		public:
+			NullTexture2DArray(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+			inline virtual uint32_t GetWidth() const override { return m_Width; }
+			inline virtual uint32_t GetHeight() const override { return m_Height; }
+
+			inline virtual TextureWrapping GetSWrapping() const override { return m_SWrapping; }
+			inline virtual TextureWrapping GetTWrapping() const override { return m_TWrapping; }
+			inline virtual const Color& GetBorderColor() const override { return m_BorderColor; }
+
+			inline virtual void SetSWrapping(TextureWrapping wrapping) override { m_SWrapping = wrapping; }
+			inline virtual void SetTWrapping(TextureWrapping wrapping) override { m_TWrapping = wrapping; }
+			inline virtual void SetBorderColor(const Color& color) override { m_BorderColor = color; }
+
+			inline virtual TextureFiltering GetMinFilter() const override { return m_MinFilter; };
+			inline virtual TextureFiltering GetMagFilter() const override { return m_MagFilter; };
+
+			inline virtual void SetMinFilter(TextureFiltering filter) override { m_MinFilter = filter; }
+			inline virtual void SetMagFilter(TextureFiltering filter) override { m_MagFilter = filter; }
+
+			inline virtual TextureFormat GetFormat() const override { return m_Format; }
+
+			virtual void Bind(uint32_t slot = 0) const override;
+			inline virtual uint32_t GetRendererID() const { return m_RendererID; }
+
+			inline virtual bool operator==(const Texture& other) const override
+			{
+				return m_RendererID == other.GetRendererID();
+			}
+
+			virtual void SetLayerCount(uint32_t layerCount) override;
+			inline virtual uint32_t GetLayerCount() const override { return (uint32_t)m_Layers.size(); }
+			inline virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+
+			inline virtual const Ref<Texture2D>& GetLayer(uint32_t layer) const override { return m_Layers[layer]; }
+		private:
+			uint32_t m_Width, m_Height;
+			TextureFiltering m_MinFilter, m_MagFilter;
+			TextureWrapping m_SWrapping, m_TWrapping;
+			Color m_BorderColor;
+			TextureFormat m_Format;
+			uint32_t m_MipLevels;
+			uint32_t m_RendererID;
+			Vector<Ref<Texture2D>> m_Layers;
+		};
+	}
+}
@@ -0,0 +1,38 @@
+#include "pcheader.h"
+#include "NullVertexArray.h"
+
+#include "NullRendererAPI.h"
+
+namespace OverEngine
+{
+	NullVertexArray::NullVertexArray()
+		: m_RendererID(NullRecorder::GenRendererID())
+	{
+	}
+
+	void NullVertexArray::Bind() const
+	{
+		NullRecorder::Record(NullCommandType::BindBuffer, m_RendererID);
+	}
+
+	void NullVertexArray::Unbind() const
+	{
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor)
+	{
+		OE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void NullVertexArray::AddVertexBuffer(const Ref<StreamingBuffer>& streamingBuffer, uint32_t instanceDivisor)
+	{
+		OE_CORE_ASSERT(streamingBuffer->GetLayout().GetElements().size(), "Streaming Buffer has no layout!");
+		m_StreamingBuffers.push_back(streamingBuffer);
+	}
+
+	void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+	{
+		m_IndexBuffer = indexBuffer;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "OverEngine/Renderer/VertexArray.h"
+
+namespace OverEngine
+{
+	class NullVertexArray : public VertexArray
+	{
+	public:
+		NullVertexArray();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor = 0) override;
+		virtual void AddVertexBuffer(const Ref<StreamingBuffer>& streamingBuffer, uint32_t instanceDivisor = 0) override;
+		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+
+		virtual const Vector<Ref<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
+		virtual const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+	private:
+		uint32_t m_RendererID;
+		Vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Vector<Ref<StreamingBuffer>> m_StreamingBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+	};
+}
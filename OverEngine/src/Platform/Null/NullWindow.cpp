@@ -0,0 +1,19 @@
+#include "pcheader.h"
+#include "NullWindow.h"
+
+namespace OverEngine
+{
+	NullWindow::NullWindow(const WindowProps& props)
+		: m_Title(props.Title), m_Width(props.Width), m_Height(props.Height)
+	{
+		OE_CORE_INFO("Creating headless window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+
+		m_Context = RendererContext::Create(this);
+		m_Context->Init();
+	}
+
+	void NullWindow::OnUpdate()
+	{
+		m_Context->SwapBuffers();
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "OverEngine/Core/Window.h"
+#include "OverEngine/Renderer/RendererContext.h"
+
+namespace OverEngine
+{
+	/**
+	 * Window without any OS window behind it, used with RendererAPI::API::Null
+	 * to run the engine on machines that have no display.
+	 */
+	class NullWindow : public Window
+	{
+	public:
+		NullWindow(const WindowProps& props);
+
+		virtual void OnUpdate() override;
+
+		inline virtual uint32_t GetWidth() const override { return m_Width; }
+		inline virtual uint32_t GetHeight() const override { return m_Height; }
+
+		// Window attributes
+		inline virtual void SetEventCallback(const EventCallbackFn& callback) override { m_EventCallback = callback; }
+		inline virtual void SetVSync(bool enabled) override { m_VSync = enabled; }
+		inline virtual bool IsVSync() const override { return m_VSync; }
+
+		inline virtual void SetTitle(const char* title) override { m_Title = title; }
+
+		inline virtual void SetMousePosition(Vector2 position) override { m_MousePosition = position; }
+		inline virtual Vector2 GetMousePosition() override { return m_MousePosition; }
+
+		inline virtual void SetClipboardText(const char* text) override { m_ClipboardText = text; }
+		inline virtual const char* GetClipboardText() override { return m_ClipboardText.c_str(); }
+
+		inline virtual void* GetNativeWindow() const override { return nullptr; }
+		inline virtual RendererContext& GetRendererContext() const override { return *m_Context; }
+	private:
+		String m_Title;
+		uint32_t m_Width, m_Height;
+		bool m_VSync = false;
+
+		Vector2 m_MousePosition = { 0.0f, 0.0f };
+		String m_ClipboardText;
+
+		EventCallbackFn m_EventCallback;
+		Scope<RendererContext> m_Context;
+	};
+}
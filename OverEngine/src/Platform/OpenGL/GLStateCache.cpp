@@ -0,0 +1,259 @@
+#include "pcheader.h"
+#include "GLStateCache.h"
+
+namespace OverEngine
+{
+	static constexpr GLuint Unknown = ~(GLuint)0;
+
+	static constexpr uint32_t MaxCachedTextureUnits = 32;
+	static constexpr uint32_t MaxCachedBufferBindings = 16;
+
+	enum CachedBufferTarget { ArrayBuffer = 0, ElementArrayBuffer, UniformBuffer, ShaderStorageBuffer, PixelUnpackBuffer, CachedBufferTargetCount };
+	enum CachedCapability { Blend = 0, DepthTest, CullFace, ScissorTest, CachedCapabilityCount };
+
+	struct GLState
+	{
+		GLuint Program;
+		GLuint VertexArray;
+		GLuint Framebuffer;
+		GLint Viewport[4];
+
+		GLuint Buffers[CachedBufferTargetCount];
+		GLuint UniformBuffers[MaxCachedBufferBindings];
+		GLuint ShaderStorageBuffers[MaxCachedBufferBindings];
+		GLuint TextureUnits[MaxCachedTextureUnits];
+
+		int8_t Capabilities[CachedCapabilityCount]; // -1 when unknown
+		GLenum BlendSourceFactor, BlendDestinationFactor;
+		GLenum BlendEquation;
+		GLenum DepthFunc;
+		int8_t DepthMask;
+
+		GLState() { Reset(); }
+
+		void Reset()
+		{
+			Program = VertexArray = Framebuffer = Unknown;
+			std::fill(std::begin(Viewport), std::end(Viewport), -1);
+
+			std::fill(std::begin(Buffers), std::end(Buffers), Unknown);
+			std::fill(std::begin(UniformBuffers), std::end(UniformBuffers), Unknown);
+			std::fill(std::begin(ShaderStorageBuffers), std::end(ShaderStorageBuffers), Unknown);
+			std::fill(std::begin(TextureUnits), std::end(TextureUnits), Unknown);
+
+			std::fill(std::begin(Capabilities), std::end(Capabilities), (int8_t)-1);
+			BlendSourceFactor = BlendDestinationFactor = BlendEquation = DepthFunc = Unknown;
+			DepthMask = -1;
+		}
+	};
+
+	static GLState s_State;
+
+	GLStateCache::Statistics GLStateCache::s_Statistics;
+	GLStateCache::Statistics GLStateCache::s_LastFrameStatistics;
+
+	static int GetBufferTargetIndex(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:          return ArrayBuffer;
+		case GL_ELEMENT_ARRAY_BUFFER:  return ElementArrayBuffer;
+		case GL_UNIFORM_BUFFER:        return UniformBuffer;
+		case GL_SHADER_STORAGE_BUFFER: return ShaderStorageBuffer;
+		case GL_PIXEL_UNPACK_BUFFER:   return PixelUnpackBuffer;
+		}
+		return -1;
+	}
+
+	static int GetCapabilityIndex(GLenum capability)
+	{
+		switch (capability)
+		{
+		case GL_BLEND:        return Blend;
+		case GL_DEPTH_TEST:   return DepthTest;
+		case GL_CULL_FACE:    return CullFace;
+		case GL_SCISSOR_TEST: return ScissorTest;
+		}
+		return -1;
+	}
+
+	// Stores value in cached and returns true if the call has to be issued
+	template<typename T>
+	static bool Update(T& cached, T value)
+	{
+		if (cached == value)
+		{
+			GLStateCache::CountElided();
+			return false;
+		}
+
+		cached = value;
+		GLStateCache::CountIssued();
+		return true;
+	}
+
+	void GLStateCache::UseProgram(GLuint program)
+	{
+		if (Update(s_State.Program, program))
+			glUseProgram(program);
+	}
+
+	void GLStateCache::BindVertexArray(GLuint vertexArray)
+	{
+		if (Update(s_State.VertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+
+			// Element buffer binding is part of the vertex array
+			s_State.Buffers[ElementArrayBuffer] = Unknown;
+		}
+	}
+
+	void GLStateCache::BindBuffer(GLenum target, GLuint buffer)
+	{
+		int index = GetBufferTargetIndex(target);
+		if (index == -1 || Update(s_State.Buffers[index], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void GLStateCache::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+	{
+		GLuint* bindings = nullptr;
+		if (target == GL_UNIFORM_BUFFER)
+			bindings = s_State.UniformBuffers;
+		else if (target == GL_SHADER_STORAGE_BUFFER)
+			bindings = s_State.ShaderStorageBuffers;
+
+		if (!bindings || index >= MaxCachedBufferBindings || Update(bindings[index], buffer))
+		{
+			glBindBufferBase(target, index, buffer);
+
+			// Also binds the generic binding point
+			int targetIndex = GetBufferTargetIndex(target);
+			if (targetIndex != -1)
+				s_State.Buffers[targetIndex] = buffer;
+		}
+	}
+
+	void GLStateCache::BindTextureUnit(GLuint unit, GLuint texture)
+	{
+		if (unit >= MaxCachedTextureUnits || Update(s_State.TextureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void GLStateCache::BindFramebuffer(GLuint framebuffer)
+	{
+		if (Update(s_State.Framebuffer, framebuffer))
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+
+	void GLStateCache::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		GLint* cached = s_State.Viewport;
+		if (cached[0] == x && cached[1] == y && cached[2] == width && cached[3] == height)
+		{
+			CountElided();
+			return;
+		}
+
+		cached[0] = x;
+		cached[1] = y;
+		cached[2] = width;
+		cached[3] = height;
+
+		CountIssued();
+		glViewport(x, y, width, height);
+	}
+
+	void GLStateCache::SetEnabled(GLenum capability, bool enabled)
+	{
+		int index = GetCapabilityIndex(capability);
+		if (index != -1 && !Update(s_State.Capabilities[index], (int8_t)enabled))
+			return;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void GLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+	{
+		if (s_State.BlendSourceFactor == sourceFactor && s_State.BlendDestinationFactor == destinationFactor)
+		{
+			CountElided();
+			return;
+		}
+
+		s_State.BlendSourceFactor = sourceFactor;
+		s_State.BlendDestinationFactor = destinationFactor;
+
+		CountIssued();
+		glBlendFunc(sourceFactor, destinationFactor);
+	}
+
+	void GLStateCache::BlendEquation(GLenum mode)
+	{
+		if (Update(s_State.BlendEquation, mode))
+			glBlendEquation(mode);
+	}
+
+	void GLStateCache::DepthFunc(GLenum func)
+	{
+		if (Update(s_State.DepthFunc, func))
+			glDepthFunc(func);
+	}
+
+	void GLStateCache::DepthMask(bool writeEnabled)
+	{
+		if (Update(s_State.DepthMask, (int8_t)writeEnabled))
+			glDepthMask(writeEnabled ? GL_TRUE : GL_FALSE);
+	}
+
+	void GLStateCache::OnProgramDeleted(GLuint program)
+	{
+		if (s_State.Program == program)
+			s_State.Program = Unknown;
+	}
+
+	void GLStateCache::OnVertexArrayDeleted(GLuint vertexArray)
+	{
+		if (s_State.VertexArray == vertexArray)
+			s_State.VertexArray = Unknown;
+	}
+
+	void GLStateCache::OnBufferDeleted(GLuint buffer)
+	{
+		for (auto* bindings : { std::begin(s_State.Buffers), std::begin(s_State.UniformBuffers), std::begin(s_State.ShaderStorageBuffers) })
+		{
+			size_t count = bindings == s_State.Buffers ? CachedBufferTargetCount : MaxCachedBufferBindings;
+			for (size_t i = 0; i < count; i++)
+				if (bindings[i] == buffer)
+					bindings[i] = Unknown;
+		}
+	}
+
+	void GLStateCache::OnTextureDeleted(GLuint texture)
+	{
+		for (auto& unit : s_State.TextureUnits)
+			if (unit == texture)
+				unit = Unknown;
+	}
+
+	void GLStateCache::OnFramebufferDeleted(GLuint framebuffer)
+	{
+		if (s_State.Framebuffer == framebuffer)
+			s_State.Framebuffer = Unknown;
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		s_State.Reset();
+	}
+
+	void GLStateCache::EndFrame()
+	{
+		s_LastFrameStatistics = s_Statistics;
+		s_Statistics = Statistics();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glad/gl.h>
+
+namespace OverEngine
+{
+	/**
+	 * Shadow copy of the GL state changed by the engine, calls which wouldn't change anything are skipped.
+	 * Bindings and fixed function state in Platform/OpenGL go through here. Code which changes
+	 * state behind its back (e.g. the ImGui backend) must call Invalidate afterwards.
+	 */
+	class GLStateCache
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t IssuedCalls = 0;
+			uint32_t ElidedCalls = 0;
+		};
+	public:
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vertexArray);
+		static void BindBuffer(GLenum target, GLuint buffer);
+		static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+		static void BindTextureUnit(GLuint unit, GLuint texture);
+		static void BindFramebuffer(GLuint framebuffer);
+		static void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE or GL_SCISSOR_TEST
+		static void SetEnabled(GLenum capability, bool enabled);
+		static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+		static void BlendEquation(GLenum mode);
+		static void DepthFunc(GLenum func);
+		static void DepthMask(bool writeEnabled);
+
+		// GL unbinds deleted objects and may reuse their names
+		static void OnProgramDeleted(GLuint program);
+		static void OnVertexArrayDeleted(GLuint vertexArray);
+		static void OnBufferDeleted(GLuint buffer);
+		static void OnTextureDeleted(GLuint texture);
+		static void OnFramebufferDeleted(GLuint framebuffer);
+
+		static void Invalidate();
+
+		// For caches kept outside (e.g. uniform values of OpenGLShader)
+		static void CountIssued() { s_Statistics.IssuedCalls++; }
+		static void CountElided() { s_Statistics.ElidedCalls++; }
+
+		// Called once per frame, statistics of the finished frame are kept
+		static void EndFrame();
+		static const Statistics& GetLastFrameStatistics() { return s_LastFrameStatistics; }
+	private:
+		static Statistics s_Statistics;
+		static Statistics s_LastFrameStatistics;
+	};
+}
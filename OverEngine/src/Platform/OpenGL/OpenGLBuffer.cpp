@@ -1,6 +1,8 @@
 #include "pcheader.h"
 #include "OpenGLBuffer.h"
 
+#include "GLStateCache.h"
+
 #include <glad/gl.h>
 
 namespace OverEngine
@@ -22,35 +24,33 @@ namespace OverEngine
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
+		GLStateCache::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void OpenGLVertexBuffer::BufferData(const float* vertices, uint32_t size, bool staticDraw /*= true*/) const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, staticDraw ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, size, vertices, staticDraw ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
 	}
 
 	void OpenGLVertexBuffer::BufferSubData(const float* vertices, uint32_t size, uint32_t offset /*= 0*/) const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, offset, size, vertices);
+		glNamedBufferSubData(m_RendererID, offset, size, vertices);
 	}
 
 	void OpenGLVertexBuffer::AllocateStorage(uint32_t size) const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
 	}
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -72,30 +72,29 @@ namespace OverEngine
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
+		GLStateCache::OnBufferDeleted(m_RendererID);
 		glDeleteBuffers(1, &m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 	void OpenGLIndexBuffer::BufferData(const uint32_t* indices, uint32_t count, bool staticDraw /*= true*/) const
 	{
 		m_Count = count;
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, staticDraw ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, count * sizeof(uint32_t), indices, staticDraw ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
 	}
 
 	void OpenGLIndexBuffer::BufferSubData(const uint32_t* indices, uint32_t count, uint32_t offset /*= 0*/) const
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint32_t), count * sizeof(uint32_t), indices);
+		glNamedBufferSubData(m_RendererID, offset * sizeof(uint32_t), count * sizeof(uint32_t), indices);
 	}
 
 	void OpenGLIndexBuffer::AllocateStorage(uint32_t count) const
@@ -104,7 +103,241 @@ namespace OverEngine
 			return;
 
 		m_Count = count;
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(m_RendererID, count * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// StreamingBuffer //////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	OpenGLStreamingBuffer::OpenGLStreamingBuffer(uint32_t regionSize, uint32_t regionCount)
+		: m_RegionSize(regionSize), m_RegionCount(regionCount)
+	{
+		OE_CORE_ASSERT(regionSize && regionCount, "StreamingBuffer must have at least one non-empty region!");
+
+		glCreateBuffers(1, &m_RendererID);
+		GLsizeiptr totalSize = (GLsizeiptr)m_RegionSize * m_RegionCount;
+
+		if (GLAD_GL_VERSION_4_4)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glNamedBufferStorage(m_RendererID, totalSize, nullptr, flags);
+			m_PersistentData = (uint8_t*)glMapNamedBufferRange(m_RendererID, 0, totalSize, flags);
+			m_RegionFences.resize(m_RegionCount, nullptr);
+		}
+		else
+		{
+			glNamedBufferData(m_RendererID, totalSize, nullptr, GL_STREAM_DRAW);
+		}
+	}
+
+	OpenGLStreamingBuffer::~OpenGLStreamingBuffer()
+	{
+		for (auto fence : m_RegionFences)
+			if (fence)
+				glDeleteSync(fence);
+
+		if (m_PersistentData)
+			glUnmapNamedBuffer(m_RendererID);
+
+		GLStateCache::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStreamingBuffer::Bind() const
+	{
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+	}
+
+	void OpenGLStreamingBuffer::Unbind() const
+	{
+		GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void OpenGLStreamingBuffer::NextRegion()
+	{
+		// Everything issued so far may read the region we are leaving
+		m_RegionFences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+		m_Head = m_CurrentRegion * m_RegionSize;
+
+		if (GLsync fence = m_RegionFences[m_CurrentRegion])
+		{
+			GLbitfield waitFlags = 0;
+			while (glClientWaitSync(fence, waitFlags, 1000000) == GL_TIMEOUT_EXPIRED)
+				waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+			glDeleteSync(fence);
+			m_RegionFences[m_CurrentRegion] = nullptr;
+		}
+	}
+
+	void* OpenGLStreamingBuffer::Map(uint32_t size, uint32_t alignment /*= 1*/)
+	{
+		OE_CORE_ASSERT(size <= m_RegionSize, "StreamingBuffer region is too small!");
+
+		uint32_t offset = (m_Head + alignment - 1) / alignment * alignment;
+
+		if (m_PersistentData)
+		{
+			if (offset + size > (m_CurrentRegion + 1) * m_RegionSize)
+			{
+				NextRegion();
+				offset = m_Head;
+			}
+
+			m_MappedOffset = offset;
+			m_Head = offset + size;
+			return m_PersistentData + offset;
+		}
+
+		// Orphan the whole buffer once it is full, the driver hands us fresh storage
+		if (offset + size > m_RegionCount * m_RegionSize)
+		{
+			glNamedBufferData(m_RendererID, (GLsizeiptr)m_RegionSize * m_RegionCount, nullptr, GL_STREAM_DRAW);
+			offset = 0;
+		}
+
+		m_MappedOffset = offset;
+		m_Head = offset + size;
+		return glMapNamedBufferRange(m_RendererID, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	}
+
+	void OpenGLStreamingBuffer::Unmap()
+	{
+		// Persistent mapping is coherent, nothing to flush
+		if (!m_PersistentData)
+			glUnmapNamedBuffer(m_RendererID);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// PixelUnpackBuffer ////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	OpenGLPixelUnpackBuffer::OpenGLPixelUnpackBuffer(uint32_t regionSize, uint32_t regionCount)
+		: m_RegionSize(regionSize), m_RegionCount(regionCount), m_RegionFences(regionCount, nullptr)
+	{
+		OE_CORE_ASSERT(regionSize && regionCount, "PixelUnpackBuffer must have at least one non-empty region!");
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, (GLsizeiptr)m_RegionSize * m_RegionCount, nullptr, GL_STREAM_DRAW);
+	}
+
+	OpenGLPixelUnpackBuffer::~OpenGLPixelUnpackBuffer()
+	{
+		for (auto fence : m_RegionFences)
+			if (fence)
+				glDeleteSync(fence);
+
+		GLStateCache::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLPixelUnpackBuffer::Bind() const
+	{
+		GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_RendererID);
+	}
+
+	void OpenGLPixelUnpackBuffer::Unbind() const
+	{
+		// Client memory uploads read through a bound unpack buffer otherwise
+		GLStateCache::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	void OpenGLPixelUnpackBuffer::NextRegion()
+	{
+		// Copies issued so far may read the region we are leaving
+		if (m_Head != m_CurrentRegion * m_RegionSize)
+			m_RegionFences[m_CurrentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_CurrentRegion = (m_CurrentRegion + 1) % m_RegionCount;
+		m_Head = m_CurrentRegion * m_RegionSize;
+
+		if (GLsync fence = m_RegionFences[m_CurrentRegion])
+		{
+			GLbitfield waitFlags = 0;
+			while (glClientWaitSync(fence, waitFlags, 1000000) == GL_TIMEOUT_EXPIRED)
+				waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+			glDeleteSync(fence);
+			m_RegionFences[m_CurrentRegion] = nullptr;
+		}
+	}
+
+	void* OpenGLPixelUnpackBuffer::Map(uint32_t size)
+	{
+		// Row starts of 4 byte pixels stay aligned
+		uint32_t offset = (m_Head + 3) / 4 * 4;
+		if (offset + size > (m_CurrentRegion + 1) * m_RegionSize)
+			return nullptr;
+
+		m_MappedOffset = offset;
+		m_Head = offset + size;
+		return glMapNamedBufferRange(m_RendererID, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	}
+
+	void OpenGLPixelUnpackBuffer::Unmap()
+	{
+		glUnmapNamedBuffer(m_RendererID);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// ShaderStorageBuffer //////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	OpenGLShaderStorageBuffer::OpenGLShaderStorageBuffer()
+	{
+		glCreateBuffers(1, &m_RendererID);
+	}
+
+	OpenGLShaderStorageBuffer::~OpenGLShaderStorageBuffer()
+	{
+		GLStateCache::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLShaderStorageBuffer::Bind(uint32_t binding) const
+	{
+		GLStateCache::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+	}
+
+	void OpenGLShaderStorageBuffer::BufferSubData(const void* data, uint32_t size, uint32_t offset /*= 0*/) const
+	{
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLShaderStorageBuffer::AllocateStorage(uint32_t size) const
+	{
+		m_Size = size;
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+	// UniformBuffer ////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////
+
+	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
+	OpenGLUniformBuffer::~OpenGLUniformBuffer()
+	{
+		GLStateCache::OnBufferDeleted(m_RendererID);
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::Bind(uint32_t binding) const
+	{
+		GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+	}
+
+	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset /*= 0*/) const
+	{
+		OE_CORE_ASSERT(offset + size <= m_Size, "UniformBuffer overflow!");
+		glNamedBufferSubData(m_RendererID, offset, size, data);
 	}
 }
@@ -2,6 +2,8 @@
 
 #include "OverEngine/Renderer/Buffer.h"
 
+struct __GLsync; // GLsync
+
 namespace OverEngine
 {
 	class OpenGLVertexBuffer : public VertexBuffer
@@ -20,6 +22,8 @@ namespace OverEngine
 
 		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
 	private:
 		uint32_t m_RendererID = 0;
 		BufferLayout m_Layout;
@@ -40,8 +44,121 @@ namespace OverEngine
 		virtual void AllocateStorage(uint32_t count) const override;
 
 		virtual uint32_t GetCount() const { return m_Count; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
 	private:
 		uint32_t m_RendererID = 0;
 		mutable uint32_t m_Count;
 	};
+
+	/**
+	 * Uses glBufferStorage + GL_MAP_PERSISTENT_BIT when available (GL 4.4), each region is guarded by a fence.
+	 * Otherwise falls back to mapping unsynchronized ranges and orphaning the buffer once it is full.
+	 */
+	class OpenGLStreamingBuffer : public StreamingBuffer
+	{
+	public:
+		OpenGLStreamingBuffer(uint32_t regionSize, uint32_t regionCount);
+		virtual ~OpenGLStreamingBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void* Map(uint32_t size, uint32_t alignment = 1) override;
+		virtual void Unmap() override;
+
+		virtual uint32_t GetMappedOffset() const override { return m_MappedOffset; }
+
+		virtual uint32_t GetRegionSize() const override { return m_RegionSize; }
+		virtual uint32_t GetRegionCount() const override { return m_RegionCount; }
+		virtual bool IsPersistentlyMapped() const override { return m_PersistentData != nullptr; }
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+		uint32_t GetRendererID() const { return m_RendererID; }
+	private:
+		void NextRegion();
+	private:
+		uint32_t m_RendererID = 0;
+		BufferLayout m_Layout;
+
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+
+		uint32_t m_CurrentRegion = 0;
+		uint32_t m_Head = 0; // Write position (in bytes) from the start of the buffer
+		uint32_t m_MappedOffset = 0;
+
+		uint8_t* m_PersistentData = nullptr;
+		Vector<::__GLsync*> m_RegionFences;
+	};
+
+	/**
+	 * Ranges are mapped unsynchronized, a fence per region keeps them from
+	 * being rewritten while the GPU may still copy from them.
+	 */
+	class OpenGLPixelUnpackBuffer : public PixelUnpackBuffer
+	{
+	public:
+		OpenGLPixelUnpackBuffer(uint32_t regionSize, uint32_t regionCount);
+		virtual ~OpenGLPixelUnpackBuffer();
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+		virtual void* Map(uint32_t size) override;
+		virtual void Unmap() override;
+
+		virtual uint32_t GetMappedOffset() const override { return m_MappedOffset; }
+
+		virtual void NextRegion() override;
+
+		virtual uint32_t GetRegionSize() const override { return m_RegionSize; }
+		virtual uint32_t GetRegionCount() const override { return m_RegionCount; }
+	private:
+		uint32_t m_RendererID = 0;
+
+		uint32_t m_RegionSize;
+		uint32_t m_RegionCount;
+
+		uint32_t m_CurrentRegion = 0;
+		uint32_t m_Head = 0; // Write position (in bytes) from the start of the buffer
+		uint32_t m_MappedOffset = 0;
+
+		Vector<::__GLsync*> m_RegionFences;
+	};
+
+	class OpenGLShaderStorageBuffer : public ShaderStorageBuffer
+	{
+	public:
+		OpenGLShaderStorageBuffer();
+		virtual ~OpenGLShaderStorageBuffer();
+
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual void BufferSubData(const void* data, uint32_t size, uint32_t offset = 0) const override;
+		virtual void AllocateStorage(uint32_t size) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_RendererID = 0;
+		mutable uint32_t m_Size = 0;
+	};
+
+	class OpenGLUniformBuffer : public UniformBuffer
+	{
+	public:
+		OpenGLUniformBuffer(uint32_t size);
+		virtual ~OpenGLUniformBuffer();
+
+		virtual void Bind(uint32_t binding) const override;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) const override;
+
+		virtual uint32_t GetSize() const override { return m_Size; }
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Size;
+	};
 }
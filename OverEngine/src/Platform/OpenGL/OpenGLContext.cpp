@@ -1,5 +1,6 @@
 #include "pcheader.h"
 #include "OpenGLContext.h"
+#include "GLStateCache.h"
 
 #include "OverEngine/Core/Window.h"
 
@@ -39,6 +40,7 @@ namespace OverEngine
 	void OpenGLContext::SwapBuffers()
 	{
 		glfwSwapBuffers(m_WindowHandle);
+		GLStateCache::EndFrame();
 	}
 
 	void OpenGLContext::Current()
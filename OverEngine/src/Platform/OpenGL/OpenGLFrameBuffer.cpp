@@ -1,6 +1,8 @@
 #include "pcheader.h"
 #include "OpenGLFrameBuffer.h"
 
+#include "GLStateCache.h"
+
 #include <glad/gl.h>
 
 namespace OverEngine
@@ -13,6 +15,10 @@ namespace OverEngine
 
 	OpenGLFrameBuffer::~OpenGLFrameBuffer()
 	{
+		GLStateCache::OnFramebufferDeleted(m_RendererID);
+		GLStateCache::OnTextureDeleted(m_ColorAttachment);
+		GLStateCache::OnTextureDeleted(m_DepthAttachment);
+
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(1, &m_ColorAttachment);
 		glDeleteTextures(1, &m_DepthAttachment);
@@ -22,41 +28,40 @@ namespace OverEngine
 	{
 		if (m_RendererID)
 		{
+			GLStateCache::OnFramebufferDeleted(m_RendererID);
+			GLStateCache::OnTextureDeleted(m_ColorAttachment);
+			GLStateCache::OnTextureDeleted(m_DepthAttachment);
+
 			glDeleteFramebuffers(1, &m_RendererID);
 			glDeleteTextures(1, &m_ColorAttachment);
 			glDeleteTextures(1, &m_DepthAttachment);
 		}
 
 		glCreateFramebuffers(1, &m_RendererID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_ColorAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Props.Width, m_Props.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureStorage2D(m_ColorAttachment, 1, GL_RGBA8, m_Props.Width, m_Props.Height);
+		glTextureParameteri(m_ColorAttachment, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_ColorAttachment, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorAttachment, 0);
+		glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0, m_ColorAttachment, 0);
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_DepthAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_DepthAttachment);
-		glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, m_Props.Width, m_Props.Height);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_DepthAttachment, 0);
-
-		OE_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "FrameBuffer is incomplete!");
+		glTextureStorage2D(m_DepthAttachment, 1, GL_DEPTH24_STENCIL8, m_Props.Width, m_Props.Height);
+		glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthAttachment, 0);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		OE_CORE_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "FrameBuffer is incomplete!");
 	}
 
 	void OpenGLFrameBuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Props.Width, m_Props.Height);
+		GLStateCache::BindFramebuffer(m_RendererID);
+		GLStateCache::Viewport(0, 0, m_Props.Width, m_Props.Height);
 	}
 
 	void OpenGLFrameBuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLStateCache::BindFramebuffer(0);
 	}
 
 	void OpenGLFrameBuffer::Resize(uint32_t width, uint32_t height)
@@ -1,6 +1,8 @@
 #include "pcheader.h"
 #include "OpenGLRendererAPI.h"
 
+#include "GLStateCache.h"
+
 #include <glad/gl.h>
 
 namespace OverEngine
@@ -42,16 +44,18 @@ namespace OverEngine
 		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
 	#endif
 
-		glEnable(GL_DEPTH_TEST);
+		GLStateCache::Invalidate();
+
+		GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
 
-		glEnable(GL_BLEND);
-		glBlendEquation(GL_FUNC_ADD);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		GLStateCache::SetEnabled(GL_BLEND, true);
+		GLStateCache::BlendEquation(GL_FUNC_ADD);
+		GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		GLStateCache::Viewport(x, y, width, height);
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const Math::Color& color)
@@ -74,10 +78,96 @@ namespace OverEngine
 		glClear(mask);
 	}
 
-	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	void OpenGLRendererAPI::SetBlendMode(BlendMode mode)
+	{
+		GLStateCache::SetEnabled(GL_BLEND, mode != BlendMode::None);
+
+		if (mode == BlendMode::Alpha)
+			GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		else if (mode == BlendMode::Additive)
+			GLStateCache::BlendFunc(GL_ONE, GL_ONE);
+	}
+
+	void OpenGLRendererAPI::BeginSampleCount()
+	{
+		if (!m_SampleQuery)
+			glCreateQueries(GL_SAMPLES_PASSED, 1, &m_SampleQuery);
+
+		glBeginQuery(GL_SAMPLES_PASSED, m_SampleQuery);
+	}
+
+	uint64_t OpenGLRendererAPI::EndSampleCount()
+	{
+		glEndQuery(GL_SAMPLES_PASSED);
+
+		GLuint64 samples = 0;
+		glGetQueryObjectui64v(m_SampleQuery, GL_QUERY_RESULT, &samples);
+		return samples;
+	}
+
+	void OpenGLRendererAPI::NextGPUTimerFrame()
+	{
+		m_GPUTimerFrame = (m_GPUTimerFrame + 1) % GPUTimerLatency;
+		GPUTimerFrame& frame = m_GPUTimerFrames[m_GPUTimerFrame];
+
+		// Queries finish in order, if the last one is available the whole frame is
+		if (frame.UsedQueries)
+		{
+			GLuint available = GL_FALSE;
+			glGetQueryObjectuiv(frame.Queries[frame.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+			// Otherwise the GPU is more than GPUTimerLatency frames behind, the frame is dropped
+			if (available)
+			{
+				m_GPUFrameTime = 0;
+				m_GPUViewTimes.fill(0);
+
+				for (uint32_t i = 0; i < frame.UsedQueries; i++)
+				{
+					GLuint64 elapsed = 0;
+					glGetQueryObjectui64v(frame.Queries[i], GL_QUERY_RESULT, &elapsed);
+					m_GPUFrameTime += elapsed;
+					m_GPUViewTimes[frame.QueryViews[i]] += elapsed;
+				}
+			}
+		}
+
+		frame.UsedQueries = 0;
+	}
+
+	void OpenGLRendererAPI::BeginGPUTimer(uint32_t view)
+	{
+		GPUTimerFrame& frame = m_GPUTimerFrames[m_GPUTimerFrame];
+		if (frame.UsedQueries == frame.Queries.size())
+		{
+			glCreateQueries(GL_TIME_ELAPSED, 1, &frame.Queries.emplace_back());
+			frame.QueryViews.emplace_back();
+		}
+
+		frame.QueryViews[frame.UsedQueries] = std::min(view, MaxGPUTimerViews - 1);
+		glBeginQuery(GL_TIME_ELAPSED, frame.Queries[frame.UsedQueries++]);
+	}
+
+	void OpenGLRendererAPI::EndGPUTimer()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+	}
+
+	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t baseVertex)
 	{
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		if (baseVertex)
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, baseVertex);
+		else
+			glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLRendererAPI::DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		if (baseInstance)
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, vertexCount, instanceCount, baseInstance);
+		else
+			glDrawArraysInstanced(GL_TRIANGLES, 0, vertexCount, instanceCount);
 	}
 
 	uint32_t OpenGLRendererAPI::GetMaxTextureSize()
@@ -94,4 +184,16 @@ namespace OverEngine
 		return texture_units;
 	}
 
+	uint32_t OpenGLRendererAPI::GetMaxArrayTextureLayers()
+	{
+		GLint array_texture_layers;
+		glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &array_texture_layers);
+		return array_texture_layers;
+	}
+
+	uint32_t OpenGLRendererAPI::GetElidedCallCount()
+	{
+		return GLStateCache::GetLastFrameStatistics().ElidedCalls;
+	}
+
 }
@@ -14,9 +14,39 @@ namespace OverEngine
 		virtual void SetClearDepth(float depth) override;
 		virtual void Clear(const ClearFlags& flags) override;
 
-		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void SetBlendMode(BlendMode mode) override;
+
+		virtual void BeginSampleCount() override;
+		virtual uint64_t EndSampleCount() override;
+
+		virtual void NextGPUTimerFrame() override;
+		virtual void BeginGPUTimer(uint32_t view) override;
+		virtual void EndGPUTimer() override;
+		virtual uint64_t GetGPUFrameTime() override { return m_GPUFrameTime; }
+		virtual uint64_t GetGPUViewTime(uint32_t view) override { return m_GPUViewTimes[std::min(view, MaxGPUTimerViews - 1)]; }
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0, uint32_t baseVertex = 0) override;
+		virtual void DrawInstanced(const Ref<VertexArray>& vertexArray, uint32_t vertexCount, uint32_t instanceCount, uint32_t baseInstance = 0) override;
 
 		virtual uint32_t GetMaxTextureSize() override;
 		virtual uint32_t GetMaxTextureSlotCount() override;
+		virtual uint32_t GetMaxArrayTextureLayers() override;
+
+		virtual uint32_t GetElidedCallCount() override;
+	private:
+		uint32_t m_SampleQuery = 0;
+
+		// GL_TIME_ELAPSED queries of the last GPUTimerLatency frames
+		struct GPUTimerFrame
+		{
+			Vector<uint32_t> Queries;
+			Vector<uint32_t> QueryViews; // View each used query was begun for
+			uint32_t UsedQueries = 0;
+		};
+
+		std::array<GPUTimerFrame, GPUTimerLatency> m_GPUTimerFrames;
+		uint32_t m_GPUTimerFrame = 0;
+		uint64_t m_GPUFrameTime = 0;
+		std::array<uint64_t, MaxGPUTimerViews> m_GPUViewTimes{};
 	};
 }
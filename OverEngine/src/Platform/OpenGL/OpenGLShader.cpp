@@ -2,6 +2,7 @@
 #include "OpenGLShader.h"
 
 #include "OpenGLIntermediateShader.h"
+#include "GLStateCache.h"
 
 #include "OverEngine/Core/FileSystem/FileSystem.h"
 
@@ -10,6 +11,150 @@
 
 namespace OverEngine
 {
+	/////// Program Binary Cache ///////
+
+	// Programs linked from files are stored as driver binaries in this directory, so later runs skip compilation
+	static const char* s_ProgramCacheDirectory = "cache/shaders";
+
+	struct ProgramBinaryHeader
+	{
+		char Magic[4] = { 'O', 'E', 'S', 'B' };
+		uint32_t Version = 1;
+		uint64_t SourceHash = 0;
+		uint64_t DriverHash = 0; // Binaries are only valid for the driver which produced them
+		uint32_t BinaryFormat = 0;
+		uint32_t BinarySize = 0;
+	};
+
+	// FNV-1a, stable across runs unlike std::hash
+	static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= ((const uint8_t*)data)[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static uint64_t HashSources(const UnorderedMap<GLenum, String>& shaderSources)
+	{
+		Vector<GLenum> stages;
+		for (const auto& src : shaderSources)
+			stages.push_back(src.first);
+		std::sort(stages.begin(), stages.end());
+
+		uint64_t hash = HashBytes(nullptr, 0);
+		for (GLenum stage : stages)
+		{
+			const String& source = shaderSources.at(stage);
+			hash = HashBytes(&stage, sizeof(stage), hash);
+			hash = HashBytes(source.data(), source.size(), hash);
+		}
+		return hash;
+	}
+
+	// 0 if the driver can't save program binaries
+	static uint64_t GetDriverHash()
+	{
+		static uint64_t driverHash = []() -> uint64_t {
+			GLint formatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			if (formatCount == 0)
+				return 0;
+
+			uint64_t hash = HashBytes(nullptr, 0);
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				if (value)
+					hash = HashBytes(value, strlen(value), hash);
+			}
+			return hash;
+		}();
+
+		return driverHash;
+	}
+
+	static std::filesystem::path GetProgramCachePath(uint64_t sourceHash)
+	{
+		char fileName[32];
+		snprintf(fileName, sizeof(fileName), "%016llx.bin", (unsigned long long)sourceHash);
+		return std::filesystem::path(s_ProgramCacheDirectory) / fileName;
+	}
+
+	// Returns 0 if there is no valid binary for sourceHash
+	static GLuint LoadProgramBinary(uint64_t sourceHash)
+	{
+		uint64_t driverHash = GetDriverHash();
+		if (!driverHash)
+			return 0;
+
+		std::ifstream in(GetProgramCachePath(sourceHash), std::ios::binary);
+		if (!in)
+			return 0;
+
+		ProgramBinaryHeader header, expected;
+		in.read((char*)&header, sizeof(header));
+		if (!in || memcmp(header.Magic, expected.Magic, sizeof(header.Magic)) != 0 || header.Version != expected.Version ||
+			header.SourceHash != sourceHash || header.DriverHash != driverHash)
+			return 0;
+
+		Vector<uint8_t> binary(header.BinarySize);
+		in.read((char*)binary.data(), binary.size());
+		if (!in)
+			return 0;
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size());
+
+		// Drivers reject binaries after updates even if the version string is the same
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		return program;
+	}
+
+	static void SaveProgramBinary(GLuint program, uint64_t sourceHash)
+	{
+		ProgramBinaryHeader header;
+		header.SourceHash = sourceHash;
+		header.DriverHash = GetDriverHash();
+		if (!header.DriverHash)
+			return;
+
+		GLint binarySize = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+		if (binarySize <= 0)
+			return;
+
+		Vector<uint8_t> binary(binarySize);
+		GLenum binaryFormat = 0;
+		glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data());
+		header.BinaryFormat = binaryFormat;
+		header.BinarySize = (uint32_t)binarySize;
+
+		std::error_code error;
+		std::filesystem::create_directories(s_ProgramCacheDirectory, error);
+
+		std::ofstream out(GetProgramCachePath(sourceHash), std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			OE_CORE_WARN("Can't write shader cache to '{0}'", s_ProgramCacheDirectory);
+			return;
+		}
+
+		out.write((const char*)&header, sizeof(header));
+		out.write((const char*)binary.data(), header.BinarySize);
+	}
+
+	/////// OpenGLShader ///////
+
 	static GLenum ShaderTypeFromString(const String& type)
 	{
 		if (type == "vertex")
@@ -21,9 +166,11 @@ namespace OverEngine
 		return 0;
 	}
 
-	OpenGLShader::OpenGLShader(const String& filePath)
-		: m_FilePath(filePath)
+	OpenGLShader::OpenGLShader(const String& filePath, const Vector<String>& defines /*= {}*/)
+		: m_FilePath(filePath), m_Defines(defines)
 	{
+		OE_PROFILE_FUNCTION();
+
 		Compile(PreProcess(FileSystem::ReadFile(filePath)));
 
 		auto lastSlash = filePath.find_last_of("/\\");
@@ -86,6 +233,7 @@ namespace OverEngine
 
 	OpenGLShader::~OpenGLShader()
 	{
+		GLStateCache::OnProgramDeleted(m_RendererID);
 		glDeleteProgram(m_RendererID);
 	}
 
@@ -107,7 +255,21 @@ namespace OverEngine
 			size_t nextLinePos = source.find_first_not_of("\r\n", eol); // Start of shader code after shader type declaration line
 			OE_CORE_ASSERT(nextLinePos != std::string::npos, "Syntax error");
 			pos = source.find(typeToken, nextLinePos); // Start of next shader type declaration line
-			shaderSources[ShaderTypeFromString(type)] = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+			String& stageSource = shaderSources[ShaderTypeFromString(type)];
+			stageSource = (pos == std::string::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+
+			// #version has to stay the first directive
+			if (!m_Defines.empty())
+			{
+				size_t versionPos = stageSource.find("#version");
+				size_t insertPos = versionPos == String::npos ? 0 : stageSource.find('\n', versionPos);
+				insertPos = insertPos == String::npos ? stageSource.size() : insertPos + 1;
+
+				String defines;
+				for (const auto& define : m_Defines)
+					defines += "#define " + define + "\n";
+				stageSource.insert(insertPos, defines);
+			}
 		}
 
 		return shaderSources;
@@ -115,15 +277,32 @@ namespace OverEngine
 
 	void OpenGLShader::Compile(const UnorderedMap<GLenum, String>& shaderSources)
 	{
+		uint64_t sourceHash = HashSources(shaderSources);
+
+		{
+			OE_PROFILE_SCOPE("OpenGLShader::LoadProgramBinary");
+			if (GLuint program = LoadProgramBinary(sourceHash))
+			{
+				SetProgram(program);
+				return;
+			}
+		}
+
 		UnorderedMap<GLenum, const char*> sources;
 		for (auto& src : shaderSources)
 			sources[src.first] = src.second.c_str();
-		Compile(sources);
+
+		if (Compile(sources))
+			SaveProgramBinary(m_RendererID, sourceHash);
 	}
 
-	void OpenGLShader::Compile(const UnorderedMap<GLenum, const char*>& shaderSources)
+	bool OpenGLShader::Compile(const UnorderedMap<GLenum, const char*>& shaderSources)
 	{
+		OE_PROFILE_FUNCTION();
+
 		GLuint program = glCreateProgram();
+		if (GetDriverHash())
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 		OE_CORE_ASSERT(shaderSources.size() <= 2, "{0} shader sources got but 2 is maximim", shaderSources.size());
 
@@ -169,8 +348,6 @@ namespace OverEngine
 
 		if (allCompiled)
 		{
-			m_RendererID = program;
-
 			glLinkProgram(program);
 
 			GLint isLinked = 0;
@@ -195,7 +372,7 @@ namespace OverEngine
 
 				OE_CORE_ERROR("{0}", infoLog.data());
 				OE_CORE_ASSERT(false, "Shader link failure!");
-				return;
+				return false;
 			}
 
 			for (auto id : glShaderIDs)
@@ -203,65 +380,120 @@ namespace OverEngine
 				glDetachShader(program, id);
 				glDeleteShader(id);
 			}
+
+			SetProgram(program);
 		}
+
+		return allCompiled;
+	}
+
+	void OpenGLShader::SetProgram(GLuint program)
+	{
+		// Reloading, the old program is replaced
+		if (m_RendererID)
+		{
+			GLStateCache::OnProgramDeleted(m_RendererID);
+			glDeleteProgram(m_RendererID);
+		}
+
+		m_RendererID = program;
+		m_UniformLocations.clear();
+		m_UniformValues.clear();
 	}
 
 	void OpenGLShader::Bind() const
 	{
-		glUseProgram(m_RendererID);
+		GLStateCache::UseProgram(m_RendererID);
 	}
 
 	void OpenGLShader::Unbind() const
 	{
-		glUseProgram(0);
+		GLStateCache::UseProgram(0);
 	}
 
-	void OpenGLShader::UploadUniformInt(const char* name, int value)
+	GLint OpenGLShader::GetUniformLocation(const char* name)
 	{
+		auto it = m_UniformLocations.find(name);
+		if (it != m_UniformLocations.end())
+			return it->second;
+
 		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform1i(location, value);
+		m_UniformLocations[name] = location;
+		return location;
+	}
+
+	bool OpenGLShader::UpdateUniformCache(GLint location, const void* value, size_t size)
+	{
+		// Inactive uniform, GL would ignore the upload anyway
+		if (location == -1)
+			return false;
+
+		auto& cached = m_UniformValues[location];
+		if (cached.size() == size && memcmp(cached.data(), value, size) == 0)
+		{
+			GLStateCache::CountElided();
+			return false;
+		}
+
+		cached.assign((const uint8_t*)value, (const uint8_t*)value + size);
+		GLStateCache::CountIssued();
+		return true;
+	}
+
+	void OpenGLShader::UploadUniformInt(const char* name, int value)
+	{
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, &value, sizeof(value)))
+			glProgramUniform1i(m_RendererID, location, value);
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const char* name, const int* value, int count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform1iv(location, count, value);
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, value, count * sizeof(int)))
+			glProgramUniform1iv(m_RendererID, location, count, value);
 	}
 
 	void OpenGLShader::UploadUniformFloat(const char* name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform1f(location, value);
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, &value, sizeof(value)))
+			glProgramUniform1f(m_RendererID, location, value);
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const char* name, const Math::Vector2& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform2f(location, value.x, value.y);
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, glm::value_ptr(value), sizeof(value)))
+			glProgramUniform2f(m_RendererID, location, value.x, value.y);
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const char* name, const Math::Vector3& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform3f(location, value.x, value.y, value.z);
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, glm::value_ptr(value), sizeof(value)))
+			glProgramUniform3f(m_RendererID, location, value.x, value.y, value.z);
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const char* name, const Math::Vector4& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniform4f(location, value.x, value.y, value.z, value.w);
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, glm::value_ptr(value), sizeof(value)))
+			glProgramUniform4f(m_RendererID, location, value.x, value.y, value.z, value.w);
 	}
 
 	void OpenGLShader::UploadUniformMat3(const char* name, const Math::Mat3x3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, glm::value_ptr(matrix), sizeof(matrix)))
+			glProgramUniformMatrix3fv(m_RendererID, location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::UploadUniformMat4(const char* name, const Math::Mat4x4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name);
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		GLint location = GetUniformLocation(name);
+		if (UpdateUniformCache(location, glm::value_ptr(matrix), sizeof(matrix)))
+			glProgramUniformMatrix4fv(m_RendererID, location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	bool OpenGLShader::Reload(String filePath)
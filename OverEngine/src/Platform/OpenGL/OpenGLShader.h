@@ -9,7 +9,7 @@ namespace OverEngine
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(const String& filePath);
+		OpenGLShader(const String& filePath, const Vector<String>& defines = {});
 		OpenGLShader(const String& name, const String& vertexSrc, const String& fragmentSrc);
 		OpenGLShader(const String& name, const char* vertexSrc, const char* fragmentSrc);
 		OpenGLShader(const String& name, const Ref<IntermediateShader>& vertexShader, const Ref<IntermediateShader>& fragmentShader);
@@ -36,11 +36,24 @@ namespace OverEngine
 		virtual bool Reload(const char* vertexSrc, const char* fragmentSrc) override;
 	private:
 		UnorderedMap<GLenum, String> PreProcess(const String& source);
+
+		// Loads the program from the binary cache if possible, compiles and caches it otherwise
 		void Compile(const UnorderedMap<GLenum, String>& shaderSources);
-		void Compile(const UnorderedMap<GLenum, const char*>& shaderSources);
+		bool Compile(const UnorderedMap<GLenum, const char*>& shaderSources);
+
+		void SetProgram(GLuint program);
+
+		GLint GetUniformLocation(const char* name);
+
+		// Returns false if the uniform at location already holds value (the upload can be skipped)
+		bool UpdateUniformCache(GLint location, const void* value, size_t size);
 	private:
 		uint32_t m_RendererID = 0;
 		String m_Name;
 		String m_FilePath;
+		Vector<String> m_Defines;
+
+		UnorderedMap<String, GLint> m_UniformLocations;
+		UnorderedMap<GLint, Vector<uint8_t>> m_UniformValues;
 	};
 }
@@ -1,6 +1,9 @@
 #include "pcheader.h"
 #include "OpenGLTexture.h"
 
+#include "GLStateCache.h"
+#include "OverEngine/Renderer/Buffer.h"
+
 #include <glad/gl.h>
 #include <stb_image.h>
 
@@ -8,6 +11,44 @@ namespace OverEngine
 {
 	namespace GAPI
 	{
+		static GLint GetGLMinFilter(TextureFiltering filter, uint32_t mipLevels)
+		{
+			if (mipLevels > 1)
+				return filter == TextureFiltering::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST;
+			return filter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST;
+		}
+
+		static GLint GetGLWrapping(TextureWrapping wrapping)
+		{
+			switch (wrapping)
+			{
+			case TextureWrapping::Repeat:         return GL_REPEAT;
+			case TextureWrapping::MirroredRepeat: return GL_MIRRORED_REPEAT;
+			case TextureWrapping::ClampToEdge:    return GL_CLAMP_TO_EDGE;
+			case TextureWrapping::ClampToBorder:  return GL_CLAMP_TO_BORDER;
+			default: return 0;
+			}
+		}
+
+		static GLenum GetGLInternalFormat(TextureFormat format)
+		{
+			switch (format)
+			{
+			case TextureFormat::RGB:  return GL_RGB8;
+			case TextureFormat::RGBA: return GL_RGBA8;
+			default: return 0;
+			}
+		}
+
+		// Storage can't go below 1x1
+		static uint32_t ClampMipLevelCount(uint32_t mipLevels, uint32_t width, uint32_t height)
+		{
+			uint32_t maxMipLevels = 1;
+			while ((std::max(width, height) >> maxMipLevels) > 0)
+				maxMipLevels++;
+			return std::min(std::max(mipLevels, 1u), maxMipLevels);
+		}
+
 		OpenGLTexture2D::OpenGLTexture2D(const String& path, TextureFiltering minFilter, TextureFiltering magFilter)
 			: m_MinFilter(minFilter), m_MagFilter(magFilter), m_Format(TextureFormat::None)
 		{
@@ -55,38 +96,19 @@ namespace OverEngine
 
 		OpenGLTexture2D::~OpenGLTexture2D()
 		{
+			GLStateCache::OnTextureDeleted(m_RendererID);
 			glDeleteTextures(1, &m_RendererID);
 		}
 
 		void OpenGLTexture2D::SetSWrapping(TextureWrapping wrapping)
 		{
-			GLint val = 0;
-			if (wrapping == TextureWrapping::Repeat)
-				val = GL_REPEAT;
-			else if (wrapping == TextureWrapping::MirroredRepeat)
-				val = GL_MIRRORED_REPEAT;
-			else if (wrapping == TextureWrapping::ClampToEdge)
-				val = GL_CLAMP_TO_EDGE;
-			else if (wrapping == TextureWrapping::ClampToBorder)
-				val = GL_CLAMP_TO_BORDER;
-
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, val);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GetGLWrapping(wrapping));
 			m_SWrapping = wrapping;
 		}
 
 		void OpenGLTexture2D::SetTWrapping(TextureWrapping wrapping)
 		{
-			GLint val = 0;
-			if (wrapping == TextureWrapping::Repeat)
-				val = GL_REPEAT;
-			else if (wrapping == TextureWrapping::MirroredRepeat)
-				val = GL_MIRRORED_REPEAT;
-			else if (wrapping == TextureWrapping::ClampToEdge)
-				val = GL_CLAMP_TO_EDGE;
-			else if (wrapping == TextureWrapping::ClampToBorder)
-				val = GL_CLAMP_TO_BORDER;
-
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, val);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GetGLWrapping(wrapping));
 			m_TWrapping = wrapping;
 		}
 
@@ -98,7 +120,7 @@ namespace OverEngine
 
 		void OpenGLTexture2D::SetMinFilter(TextureFiltering filter)
 		{
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, filter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GetGLMinFilter(filter, m_MipLevels));
 			m_MinFilter = filter;
 		}
 
@@ -110,30 +132,42 @@ namespace OverEngine
 
 		void OpenGLTexture2D::Bind(uint32_t slot /*= 0*/) const
 		{
-			glBindTextureUnit(slot, m_RendererID);
+			GLStateCache::BindTextureUnit(slot, m_RendererID);
 		}
 
-		void OpenGLTexture2D::AllocateStorage(TextureFormat format, uint32_t width, uint32_t height)
+		void OpenGLTexture2D::AllocateStorage(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels /*= 1*/)
 		{
-			GLenum internalFormat = 0;
-			if (format == TextureFormat::RGB)
-			{
-				internalFormat = GL_RGB8;
-			}
-			else if (format == TextureFormat::RGBA)
-			{
-				internalFormat = GL_RGBA8;
-			}
+			OE_CORE_ASSERT(m_ArrayLayer == -1, "Storage of an array layer is owned by the array!");
 
 			m_Width = width;
 			m_Height = height;
 			m_Format = format;
+			m_MipLevels = ClampMipLevelCount(mipLevels, width, height);
 
+			GLStateCache::OnTextureDeleted(m_RendererID);
 			glDeleteTextures(1, &m_RendererID);
 			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-			glTextureStorage2D(m_RendererID, 1, internalFormat, width, height);
+			glTextureStorage2D(m_RendererID, m_MipLevels, GetGLInternalFormat(format), width, height);
 
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MinFilter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST);
+			ApplyParameters();
+		}
+
+		void OpenGLTexture2D::CreateView(uint32_t arrayRendererID, uint32_t internalFormat, int layer)
+		{
+			GLStateCache::OnTextureDeleted(m_RendererID);
+			glDeleteTextures(1, &m_RendererID);
+
+			// Views need a name which was never bound, glCreateTextures would create the object
+			glGenTextures(1, &m_RendererID);
+			glTextureView(m_RendererID, GL_TEXTURE_2D, arrayRendererID, internalFormat, 0, m_MipLevels, layer, 1);
+			m_ArrayLayer = layer;
+
+			ApplyParameters();
+		}
+
+		void OpenGLTexture2D::ApplyParameters()
+		{
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GetGLMinFilter(m_MinFilter, m_MipLevels));
 			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, m_MagFilter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST);
 
 			SetTWrapping(m_TWrapping);
@@ -142,7 +176,7 @@ namespace OverEngine
 			glTextureParameterfv(m_RendererID, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(m_BorderColor));
 		}
 
-		void OpenGLTexture2D::SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset /*= 0*/, int yOffset /*= 0*/)
+		void OpenGLTexture2D::SubImage(const unsigned char* pixels, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset /*= 0*/, int yOffset /*= 0*/, uint32_t level /*= 0*/)
 		{
 			m_Format = dataFormat;
 
@@ -155,7 +189,148 @@ namespace OverEngine
 			{
 				GLdataFormat = GL_RGBA;
 			}
-			glTextureSubImage2D(m_RendererID, 0, xOffset, yOffset, width, height, GLdataFormat, GL_UNSIGNED_BYTE, pixels);
+			glTextureSubImage2D(m_RendererID, level, xOffset, yOffset, width, height, GLdataFormat, GL_UNSIGNED_BYTE, pixels);
+		}
+
+		void OpenGLTexture2D::SubImage(const PixelUnpackBuffer& buffer, uint32_t offset, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset /*= 0*/, int yOffset /*= 0*/)
+		{
+			// With an unpack buffer bound the pixels pointer is an offset into it
+			buffer.Bind();
+			SubImage((const unsigned char*)(uintptr_t)offset, width, height, dataFormat, xOffset, yOffset);
+			buffer.Unbind();
+		}
+
+		void OpenGLTexture2D::CopySubImage(const Texture2D& source, int sourceX, int sourceY, uint32_t width, uint32_t height, int xOffset /*= 0*/, int yOffset /*= 0*/)
+		{
+			glCopyImageSubData(source.GetRendererID(), GL_TEXTURE_2D, 0, sourceX, sourceY, 0, m_RendererID, GL_TEXTURE_2D, 0, xOffset, yOffset, 0, width, height, 1);
+		}
+
+		void OpenGLTexture2D::GenerateMipmaps()
+		{
+			if (m_MipLevels > 1)
+				glGenerateTextureMipmap(m_RendererID);
+		}
+
+		/////////////////////////////////////////////////////////
+		// Texture2DArray ///////////////////////////////////////
+		/////////////////////////////////////////////////////////
+
+		OpenGLTexture2DArray::OpenGLTexture2DArray(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels)
+			: m_Width(width), m_Height(height),
+			m_MinFilter(TextureFiltering::Linear), m_MagFilter(TextureFiltering::Linear),
+			m_SWrapping(TextureWrapping::Repeat), m_TWrapping(TextureWrapping::Repeat),
+			m_BorderColor(1.0f), m_Format(format), m_MipLevels(ClampMipLevelCount(mipLevels, width, height))
+		{
+		}
+
+		OpenGLTexture2DArray::~OpenGLTexture2DArray()
+		{
+			GLStateCache::OnTextureDeleted(m_RendererID);
+			glDeleteTextures(1, &m_RendererID);
+		}
+
+		void OpenGLTexture2DArray::SetSWrapping(TextureWrapping wrapping)
+		{
+			m_SWrapping = wrapping;
+			if (m_RendererID)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GetGLWrapping(wrapping));
+		}
+
+		void OpenGLTexture2DArray::SetTWrapping(TextureWrapping wrapping)
+		{
+			m_TWrapping = wrapping;
+			if (m_RendererID)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GetGLWrapping(wrapping));
+		}
+
+		void OpenGLTexture2DArray::SetBorderColor(const Color& color)
+		{
+			m_BorderColor = color;
+			if (m_RendererID)
+				glTextureParameterfv(m_RendererID, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(color));
+		}
+
+		void OpenGLTexture2DArray::SetMinFilter(TextureFiltering filter)
+		{
+			m_MinFilter = filter;
+			if (m_RendererID)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GetGLMinFilter(filter, m_MipLevels));
+		}
+
+		void OpenGLTexture2DArray::SetMagFilter(TextureFiltering filter)
+		{
+			m_MagFilter = filter;
+			if (m_RendererID)
+				glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, filter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST);
+		}
+
+		void OpenGLTexture2DArray::Bind(uint32_t slot /*= 0*/) const
+		{
+			GLStateCache::BindTextureUnit(slot, m_RendererID);
+		}
+
+		void OpenGLTexture2DArray::ApplyParameters()
+		{
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GetGLMinFilter(m_MinFilter, m_MipLevels));
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, m_MagFilter == TextureFiltering::Linear ? GL_LINEAR : GL_NEAREST);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GetGLWrapping(m_SWrapping));
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GetGLWrapping(m_TWrapping));
+			glTextureParameterfv(m_RendererID, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(m_BorderColor));
+		}
+
+		void OpenGLTexture2DArray::SetLayerCount(uint32_t layerCount)
+		{
+			uint32_t oldLayerCount = (uint32_t)m_Layers.size();
+			if (layerCount == oldLayerCount)
+				return;
+
+			GLenum internalFormat = GetGLInternalFormat(m_Format);
+
+			uint32_t rendererID = 0;
+			if (layerCount)
+			{
+				glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &rendererID);
+				glTextureStorage3D(rendererID, m_MipLevels, internalFormat, m_Width, m_Height, layerCount);
+
+				// Storage is immutable, growing means copying the kept layers over
+				uint32_t keptLayers = std::min(layerCount, oldLayerCount);
+				for (uint32_t level = 0; keptLayers && level < m_MipLevels; level++)
+				{
+					glCopyImageSubData(
+						m_RendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+						rendererID, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+						std::max(m_Width >> level, 1u), std::max(m_Height >> level, 1u), keptLayers
+					);
+				}
+			}
+
+			GLStateCache::OnTextureDeleted(m_RendererID);
+			glDeleteTextures(1, &m_RendererID);
+			m_RendererID = rendererID;
+
+			if (m_RendererID)
+				ApplyParameters();
+
+			m_Layers.resize(layerCount);
+			for (uint32_t layer = 0; layer < layerCount; layer++)
+			{
+				if (!m_Layers[layer])
+				{
+					auto view = CreateRef<OpenGLTexture2D>();
+					view->m_Width = m_Width;
+					view->m_Height = m_Height;
+					view->m_Format = m_Format;
+					view->m_MipLevels = m_MipLevels;
+					view->m_MinFilter = m_MinFilter;
+					view->m_MagFilter = m_MagFilter;
+					view->m_SWrapping = m_SWrapping;
+					view->m_TWrapping = m_TWrapping;
+					m_Layers[layer] = view;
+				}
+
+				// Old views still point to the old storage
+				std::static_pointer_cast<OpenGLTexture2D>(m_Layers[layer])->CreateView(m_RendererID, internalFormat, (int)layer);
+			}
 		}
 	}
 
@@ -41,18 +41,84 @@ namespace OverEngine
 				return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
 			}
 
-			virtual void AllocateStorage(TextureFormat format, uint32_t width, uint32_t height) override;
-			virtual void SubImage(const unsigned char* image, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0) override;
+			virtual void AllocateStorage(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels = 1) override;
+			virtual void SubImage(const unsigned char* image, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0, uint32_t level = 0) override;
+			virtual void SubImage(const PixelUnpackBuffer& buffer, uint32_t offset, uint32_t width, uint32_t height, TextureFormat dataFormat, int xOffset = 0, int yOffset = 0) override;
+			virtual void CopySubImage(const Texture2D& source, int sourceX, int sourceY, uint32_t width, uint32_t height, int xOffset = 0, int yOffset = 0) override;
 
-			inline virtual Vector<Ref<::OverEngine::Texture2D>>& GetMemberTextures() override { return m_Members; }
+			virtual void GenerateMipmaps() override;
+			inline virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+
+			inline virtual int GetArrayLayer() const override { return m_ArrayLayer; }
+
+			inline virtual Vector<::OverEngine::Texture2D*>& GetMemberTextures() override { return m_Members; }
+		private:
+			// Turns this texture into a view of layer in the array texture
+			void CreateView(uint32_t arrayRendererID, uint32_t internalFormat, int layer);
+			void ApplyParameters();
+
+			friend class OpenGLTexture2DArray;
+		private:
+			uint32_t m_Width, m_Height;
+			TextureFiltering m_MinFilter, m_MagFilter;
+			TextureWrapping m_SWrapping, m_TWrapping;
+			Color m_BorderColor;
+			TextureFormat m_Format;
+			uint32_t m_MipLevels = 1;
+			uint32_t m_RendererID = 0;
+			int m_ArrayLayer = -1;
+			Vector<::OverEngine::Texture2D*> m_Members;
+		};
+
+		class OpenGLTexture2DArray : public Texture2DArray
+		{
+		public:
+			OpenGLTexture2DArray(TextureFormat format, uint32_t width, uint32_t height, uint32_t mipLevels);
+			virtual ~OpenGLTexture2DArray();
+
+			inline virtual uint32_t GetWidth() const override { return m_Width; }
+			inline virtual uint32_t GetHeight() const override { return m_Height; }
+
+			inline virtual TextureWrapping GetSWrapping() const override { return m_SWrapping; }
+			inline virtual TextureWrapping GetTWrapping() const override { return m_TWrapping; }
+			inline virtual const Color& GetBorderColor() const override { return m_BorderColor; }
+
+			virtual void SetSWrapping(TextureWrapping wrapping) override;
+			virtual void SetTWrapping(TextureWrapping wrapping) override;
+			virtual void SetBorderColor(const Color& color) override;
+
+			inline virtual TextureFiltering GetMinFilter() const override { return m_MinFilter; };
+			inline virtual TextureFiltering GetMagFilter() const override { return m_MagFilter; };
+
+			virtual void SetMinFilter(TextureFiltering filter) override;
+			virtual void SetMagFilter(TextureFiltering filter) override;
+
+			inline virtual TextureFormat GetFormat() const override { return m_Format; }
+
+			virtual void Bind(uint32_t slot = 0) const override;
+			inline virtual uint32_t GetRendererID() const { return m_RendererID; }
+
+			inline virtual bool operator==(const Texture& other) const override
+			{
+				return m_RendererID == other.GetRendererID();
+			}
+
+			virtual void SetLayerCount(uint32_t layerCount) override;
+			inline virtual uint32_t GetLayerCount() const override { return (uint32_t)m_Layers.size(); }
+			inline virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+
+			inline virtual const Ref<Texture2D>& GetLayer(uint32_t layer) const override { return m_Layers[layer]; }
+		private:
+			void ApplyParameters();
 		private:
 			uint32_t m_Width, m_Height;
 			TextureFiltering m_MinFilter, m_MagFilter;
 			TextureWrapping m_SWrapping, m_TWrapping;
 			Color m_BorderColor;
 			TextureFormat m_Format;
+			uint32_t m_MipLevels;
 			uint32_t m_RendererID = 0;
-			Vector<Ref<::OverEngine::Texture2D>> m_Members;
+			Vector<Ref<Texture2D>> m_Layers;
 		};
 	}
 }
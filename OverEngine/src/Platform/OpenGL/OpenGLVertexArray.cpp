@@ -1,6 +1,9 @@
 #include "pcheader.h"
 #include "OpenGLVertexArray.h"
 
+#include "OpenGLBuffer.h"
+#include "GLStateCache.h"
+
 #include <glad/gl.h>
 
 namespace OverEngine
@@ -20,6 +23,10 @@ namespace OverEngine
 		case ShaderDataType::Int3:     return GL_INT;
 		case ShaderDataType::Int4:     return GL_INT;
 		case ShaderDataType::Bool:     return GL_BOOL;
+		case ShaderDataType::UInt:     return GL_UNSIGNED_INT;
+		case ShaderDataType::UByte4:   return GL_UNSIGNED_BYTE;
+		case ShaderDataType::UShort2:  return GL_UNSIGNED_SHORT;
+		case ShaderDataType::Half2:    return GL_HALF_FLOAT;
 		}
 
 		OE_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -33,49 +40,80 @@ namespace OverEngine
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
+		GLStateCache::OnVertexArrayDeleted(m_RendererID);
 		glDeleteVertexArrays(1, &m_RendererID);
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
-		glBindVertexArray(m_RendererID);
+		GLStateCache::BindVertexArray(m_RendererID);
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		GLStateCache::BindVertexArray(0);
 	}
 
-	void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
+	void OpenGLVertexArray::AddVertexAttributes(uint32_t buffer, const BufferLayout& layout, uint32_t instanceDivisor)
 	{
-		OE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
-
-		glBindVertexArray(m_RendererID);
-		vertexBuffer->Bind();
+		// Each vertex buffer gets its own binding point, attributes are set up without binding anything
+		uint32_t bindingIndex = m_VertexBufferBindingCount++;
+		glVertexArrayVertexBuffer(m_RendererID, bindingIndex, buffer, 0, layout.GetStride());
+		glVertexArrayBindingDivisor(m_RendererID, bindingIndex, instanceDivisor);
 
 		uint32_t index = 0;
-		const auto& layout = vertexBuffer->GetLayout();
 		for (const auto& element : layout)
 		{
-			glEnableVertexAttribArray(index + m_VertexBufferIndexOffset);
-			glVertexAttribPointer(index + m_VertexBufferIndexOffset,
-				element.GetComponentCount(),
-				ShaderDataTypeToOpenGLBaseType(element.Type),
-				element.Normalized ? GL_TRUE : GL_FALSE,
-				layout.GetStride(),
-				(const void*)(intptr_t)element.Offset);
+			uint32_t attributeIndex = index + m_VertexBufferIndexOffset;
+			glEnableVertexArrayAttrib(m_RendererID, attributeIndex);
+
+			GLenum baseType = ShaderDataTypeToOpenGLBaseType(element.Type);
+			if (element.IsInteger())
+			{
+				// Integer attributes must not be converted to float
+				glVertexArrayAttribIFormat(m_RendererID, attributeIndex,
+					element.GetComponentCount(),
+					baseType,
+					element.Offset);
+			}
+			else
+			{
+				glVertexArrayAttribFormat(m_RendererID, attributeIndex,
+					element.GetComponentCount(),
+					baseType,
+					element.Normalized ? GL_TRUE : GL_FALSE,
+					element.Offset);
+			}
+
+			glVertexArrayAttribBinding(m_RendererID, attributeIndex, bindingIndex);
+
 			index++;
 		}
 
-		m_VertexBuffers.push_back(vertexBuffer);
 		m_VertexBufferIndexOffset += (uint32_t)layout.GetElements().size();
 	}
 
-	void OpenGLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
+	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor)
+	{
+		OE_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+
+		uint32_t buffer = std::static_pointer_cast<OpenGLVertexBuffer>(vertexBuffer)->GetRendererID();
+		AddVertexAttributes(buffer, vertexBuffer->GetLayout(), instanceDivisor);
+		m_VertexBuffers.push_back(vertexBuffer);
+	}
+
+	void OpenGLVertexArray::AddVertexBuffer(const Ref<StreamingBuffer>& streamingBuffer, uint32_t instanceDivisor)
 	{
-		glBindVertexArray(m_RendererID);
-		indexBuffer->Bind();
+		OE_CORE_ASSERT(streamingBuffer->GetLayout().GetElements().size(), "Streaming Buffer has no layout!");
 
+		uint32_t buffer = std::static_pointer_cast<OpenGLStreamingBuffer>(streamingBuffer)->GetRendererID();
+		AddVertexAttributes(buffer, streamingBuffer->GetLayout(), instanceDivisor);
+		m_StreamingBuffers.push_back(streamingBuffer);
+	}
+
+	void OpenGLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
+	{
+		glVertexArrayElementBuffer(m_RendererID, std::static_pointer_cast<OpenGLIndexBuffer>(indexBuffer)->GetRendererID());
 		m_IndexBuffer = indexBuffer;
 	}
 }
@@ -13,15 +13,20 @@ namespace OverEngine
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
-		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer, uint32_t instanceDivisor = 0) override;
+		virtual void AddVertexBuffer(const Ref<StreamingBuffer>& streamingBuffer, uint32_t instanceDivisor = 0) override;
 		virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
 
 		virtual const Vector<Ref<VertexBuffer>>& GetVertexBuffers() const { return m_VertexBuffers; }
 		virtual const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
+	private:
+		void AddVertexAttributes(uint32_t buffer, const BufferLayout& layout, uint32_t instanceDivisor);
 	private:
 		uint32_t m_RendererID;
 		uint32_t m_VertexBufferIndexOffset = 0;
+		uint32_t m_VertexBufferBindingCount = 0;
 		Vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Vector<Ref<StreamingBuffer>> m_StreamingBuffers;
 		Ref<IndexBuffer> m_IndexBuffer;
 	};
 }
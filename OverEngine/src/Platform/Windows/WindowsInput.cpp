@@ -11,6 +11,9 @@ namespace OverEngine
 	bool Input::IsKeyPressed(KeyCode keycode)
 	{
 		auto window = static_cast<GLFWwindow*>(GET_MAIN_NATIVE_WINDOW);
+		if (!window)
+			return false;
+
 		auto state = glfwGetKey(window, (int)keycode);
 		return state == (int)KeyTrigger::Press;
 	}
@@ -18,6 +21,9 @@ namespace OverEngine
 	bool Input::IsMouseButtonPressed(KeyCode button)
 	{
 		auto window = static_cast<GLFWwindow*>(GET_MAIN_NATIVE_WINDOW);
+		if (!window)
+			return false;
+
 		auto state = glfwGetMouseButton(window, (int)button);
 		return state == (int)KeyTrigger::Press;
 	}
@@ -25,6 +31,9 @@ namespace OverEngine
 	Vector2 Input::GetMousePosition()
 	{
 		auto window = static_cast<GLFWwindow*>(GET_MAIN_NATIVE_WINDOW);
+		if (!window)
+			return Application::Get().GetWindow().GetMousePosition();
+
 		double xpos, ypos;
 		glfwGetCursorPos(window, &xpos, &ypos);
 
@@ -2,20 +2,23 @@
 
 #include "WindowsTime.h"
 
-#include <GLFW/glfw3.h>
+#include <chrono>
 
 namespace OverEngine
 {
 	Time* Time::s_Instance = new WindowsTime();
 
+	// Not glfwGetTime, GLFW is never initialized with RendererAPI::API::Null
+	static const auto s_StartTime = std::chrono::steady_clock::now();
+
 	float WindowsTime::GetTimeImpl()
 	{
-		return (float)glfwGetTime();
+		return (float)GetTimeDoubleImpl();
 	}
 
 	double WindowsTime::GetTimeDoubleImpl()
 	{
-		return glfwGetTime();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - s_StartTime).count();
 	}
 
 }
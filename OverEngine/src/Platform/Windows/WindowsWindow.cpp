@@ -9,6 +9,7 @@
 
 #include "OverEngine/Renderer/RendererContext.h"
 #include "OverEngine/Renderer/RendererAPI.h"
+#include "Platform/Null/NullWindow.h"
 
 namespace OverEngine
 {
@@ -21,6 +22,9 @@ namespace OverEngine
 
 	Scope<Window> Window::Create(const WindowProps& props)
 	{
+		if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+			return CreateScope<NullWindow>(props);
+
 		return CreateScope<WindowsWindow>(props);
 	}
 
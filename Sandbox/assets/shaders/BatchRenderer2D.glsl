@@ -1,17 +1,30 @@
 #type vertex
 #version 450 core
 
-layout(location = 0) in vec4 a_Position;
-layout(location = 1) in vec4 a_Color; // Tint
-layout(location = 2) in float a_TexSlot; // Texture Unit or -1 for no texture
-layout(location = 3) in float a_TexFilter; // Linear / Point
-layout(location = 4) in float a_TexAlphaClippingThreshold;
-layout(location = 5) in vec2 a_TexWrapping; // Repeat, MirroredRepeat, ...
-layout(location = 6) in vec4 a_TexBorderColor; // Used for ClampToBorder
-layout(location = 7) in vec4 a_TexRect; // 0 -> 1 Rect from Atlas
-layout(location = 8) in vec2 a_TexSize; // Texture size in pixels
-layout(location = 9) in vec2 a_TexCoord; // UV Coord
-layout(location = 10) in vec4 a_TexCoordRange;
+layout(location = 0) in vec3 a_Position; // World space
+layout(location = 1) in vec4 a_Color; // Tint (RGBA8, normalized)
+layout(location = 2) in int a_TexDescriptor; // Descriptor index | (Slot + 1) << 24, 0 for no texture
+layout(location = 3) in vec2 a_TexCorner; // 0 or 1 per axis, min or max corner of the descriptor's CoordRange
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+struct TextureDescriptor
+{
+	vec4 Rect; // 0 -> 1 Rect from Atlas
+	vec4 BorderColor; // Used for ClampToBorder
+	vec4 CoordRange; // UV Coord of min & max corners
+	vec2 Size; // Texture size in pixels
+	float AlphaClippingThreshold;
+	int Params; // Filter (4 bits) | SWrapping (4 bits) | TWrapping (4 bits) | HardwareSampling (1 bit) | Page layer << 16
+};
+
+layout(std430, binding = 0) readonly buffer TextureDescriptors
+{
+	TextureDescriptor u_TextureDescriptors[];
+};
 
 flat out vec4 v_Color;
 flat out int v_TexSlot;
@@ -19,26 +32,44 @@ flat out int v_TexFilter;
 flat out float v_TexAlphaClippingThreshold;
 flat out int v_TexSWrapping;
 flat out int v_TexTWrapping;
+flat out int v_TexHardwareSampling;
+flat out int v_TexLayer;
 flat out vec4 v_TexBorderColor;
 flat out vec4 v_TexRect;
 flat out vec2 v_TexSize;
 out vec2 v_TexCoord;
 flat out vec4 v_TexCoordRange;
 
+// Unpacks Descriptor index | (Slot + 1) << 24
+void FetchTextureDescriptor(int texDescriptor)
+{
+	v_TexSlot = ((texDescriptor >> 24) & 0xFF) - 1;
+	if (v_TexSlot == -1)
+		return;
+
+	TextureDescriptor descriptor = u_TextureDescriptors[texDescriptor & 0xFFFFFF];
+	v_TexFilter = descriptor.Params & 0xF;
+	v_TexSWrapping = (descriptor.Params >> 4) & 0xF;
+	v_TexTWrapping = (descriptor.Params >> 8) & 0xF;
+	v_TexHardwareSampling = (descriptor.Params >> 12) & 0x1;
+	v_TexLayer = (descriptor.Params >> 16) & 0xFFFF;
+	v_TexAlphaClippingThreshold = descriptor.AlphaClippingThreshold;
+	v_TexBorderColor = descriptor.BorderColor;
+	v_TexRect = descriptor.Rect;
+	v_TexSize = descriptor.Size;
+	v_TexCoordRange = descriptor.CoordRange;
+}
+
 void main()
 {
-	gl_Position = a_Position;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 	v_Color = a_Color;
-	v_TexSlot = int(a_TexSlot);
-	v_TexSWrapping = int(a_TexWrapping.x);
-	v_TexTWrapping = int(a_TexWrapping.y);
-	v_TexFilter = int(a_TexFilter);
-	v_TexAlphaClippingThreshold = a_TexAlphaClippingThreshold;
-	v_TexBorderColor = a_TexBorderColor;
-	v_TexRect = a_TexRect;
-	v_TexSize = a_TexSize;
-	v_TexCoord = vec2(a_TexCoord.x, 1 - a_TexCoord.y);
-	v_TexCoordRange = a_TexCoordRange;
+#ifndef UNTEXTURED
+	FetchTextureDescriptor(a_TexDescriptor);
+
+	vec2 texCoord = mix(v_TexCoordRange.xy, v_TexCoordRange.zw, a_TexCorner);
+	v_TexCoord = vec2(texCoord.x, 1 - texCoord.y);
+#endif
 }
 
 #type fragment
@@ -48,23 +79,47 @@ void main()
 
 layout(location = 0) out vec4 o_Color;
 
+// Permutations, see GetBatchShader in Renderer2D.cpp. Without a sampling one, the path is picked per fragment
+//   UNTEXTURED   : No quad of the batch is textured
+//   POINT_CLAMP  : Every textured quad is hardware sampled with Nearest filtering
+//   LINEAR_CLAMP : Every textured quad is hardware sampled with Linear filtering
+//   ALPHA_CLIP   : Some textured quads can drop to the alpha clipping threshold
+
+// Every atlas is a layer of u_Pages (see TextureManager::SetPaged), otherwise one atlas per slot
+#ifdef OE_TEXTURE_PAGES
+uniform sampler2DArray u_Pages;
+
+#define Atlas sampler2DArray
+#define AtlasSize(atlas) textureSize(atlas, 0).xy
+#define AtlasFetch(atlas, texel) texelFetch(atlas, ivec3(texel, v_TexLayer), 0)
+#define AtlasSample(atlas, coord) texture(atlas, vec3(coord, v_TexLayer))
+#else
 uniform sampler2D[32] u_Slots;
 
+#define Atlas sampler2D
+#define AtlasSize(atlas) textureSize(atlas, 0)
+#define AtlasFetch(atlas, texel) texelFetch(atlas, ivec2(texel), 0)
+#define AtlasSample(atlas, coord) texture(atlas, coord)
+#endif
+uniform int u_Overdraw; // Debug mode, see Renderer2D::SetOverdrawDebug
+
 flat in vec4 v_Color;
 flat in int v_TexSlot;
 flat in int v_TexFilter;
 flat in float v_TexAlphaClippingThreshold;
 flat in int v_TexSWrapping;
 flat in int v_TexTWrapping;
+flat in int v_TexHardwareSampling;
+flat in int v_TexLayer;
 flat in vec4 v_TexBorderColor;
 flat in vec4 v_TexRect;
 flat in vec2 v_TexSize;
 in vec2 v_TexCoord;
 flat in vec4 v_TexCoordRange;
 
-vec4 PointSampleFromAtlas(sampler2D slot, vec2 coord);
+vec4 PointSampleFromAtlas(Atlas slot, vec2 coord);
 
-vec4 BiLinearSampleFromAtlas(sampler2D slot, vec2 coord)
+vec4 BiLinearSampleFromAtlas(Atlas slot, vec2 coord)
 {
 	vec2 texelSize = vec2(1 / v_TexSize.x, 1 / v_TexSize.y);
 
@@ -153,7 +208,7 @@ float Wrap(float value, int wrapping)
 	return value;
 }
 
-vec4 PointSampleFromAtlas(sampler2D slot, vec2 coord)
+vec4 PointSampleFromAtlas(Atlas slot, vec2 coord)
 {
 	if ((v_TexSWrapping == 4 && (coord.x > 1 || coord.x < 0)) || (v_TexTWrapping == 4 && (coord.y > 1 || coord.y < 0)))
 		return v_TexBorderColor; // ClampToBorder
@@ -163,59 +218,96 @@ vec4 PointSampleFromAtlas(sampler2D slot, vec2 coord)
 
 	coord.x = clamp(coord.x, 0.001, 0.999);
 	coord.y = clamp(coord.y, 0.001, 0.999);
-	return texture(slot, vec2(v_TexRect.x + coord.x * v_TexRect.z, v_TexRect.y + coord.y * v_TexRect.w));
+
+	// The atlas sampler is linear, fetch to keep the point sample exact
+	vec2 atlasCoord = vec2(v_TexRect.x + coord.x * v_TexRect.z, v_TexRect.y + coord.y * v_TexRect.w);
+	return AtlasFetch(slot, atlasCoord * AtlasSize(slot));
 }
 
-vec4 Sample(sampler2D slot)
+// Renderer2D only sets HardwareSampling when the sampled area can't leave the rect
+// (plus the extruded gutter), the sampler's ClampToEdge + Linear + mips do the rest
+vec4 HardwarePointSampleFromAtlas(Atlas slot, vec2 coord)
 {
+	vec2 texel = min(floor(clamp(coord, 0.0, 1.0) * v_TexSize), v_TexSize - 1.0);
+	return AtlasFetch(slot, round(v_TexRect.xy * AtlasSize(slot)) + texel);
+}
+
+vec4 HardwareLinearSampleFromAtlas(Atlas slot, vec2 coord)
+{
+	return AtlasSample(slot, v_TexRect.xy + clamp(coord, 0.0, 1.0) * v_TexRect.zw);
+}
+
+vec4 Sample(Atlas slot)
+{
+#if defined(POINT_CLAMP)
+	vec4 color = HardwarePointSampleFromAtlas(slot, v_TexCoord);
+#elif defined(LINEAR_CLAMP)
+	vec4 color = HardwareLinearSampleFromAtlas(slot, v_TexCoord);
+#else
 	vec4 color;
-	if (v_TexFilter == 1)
-		color = PointSampleFromAtlas(slot, v_TexCoord) * v_Color;
+	if (v_TexHardwareSampling != 0)
+		color = v_TexFilter == 1 ? HardwarePointSampleFromAtlas(slot, v_TexCoord) : HardwareLinearSampleFromAtlas(slot, v_TexCoord);
+	else if (v_TexFilter == 1)
+		color = PointSampleFromAtlas(slot, v_TexCoord);
 	else
-		color = BiLinearSampleFromAtlas(slot, v_TexCoord) * v_Color;
+		color = BiLinearSampleFromAtlas(slot, v_TexCoord);
+#endif
+	color *= v_Color;
 
+#ifdef ALPHA_CLIP
 	if (color.a <= v_TexAlphaClippingThreshold) // Handle Alpha clipping
 		discard;
+#endif
 
 	return color;
 }
 
 void main()
 {
+#if defined(UNTEXTURED)
+	o_Color = v_Color;
+#elif defined(OE_TEXTURE_PAGES)
+	o_Color = v_TexSlot == -1 ? v_Color : Sample(u_Pages);
+#else
 	switch (v_TexSlot)
 	{
-	case -1 : o_Color = v_Color; return; // Alpha clipping handled by Renderer2D class in C++
-	case  0 : o_Color = Sample(u_Slots[0 ]); return;
-	case  1 : o_Color = Sample(u_Slots[1 ]); return;
-	case  2 : o_Color = Sample(u_Slots[2 ]); return;
-	case  3 : o_Color = Sample(u_Slots[3 ]); return;
-	case  4 : o_Color = Sample(u_Slots[4 ]); return;
-	case  5 : o_Color = Sample(u_Slots[5 ]); return;
-	case  6 : o_Color = Sample(u_Slots[6 ]); return;
-	case  7 : o_Color = Sample(u_Slots[7 ]); return;
-	case  8 : o_Color = Sample(u_Slots[8 ]); return;
-	case  9 : o_Color = Sample(u_Slots[9 ]); return;
-	case 10 : o_Color = Sample(u_Slots[10]); return;
-	case 11 : o_Color = Sample(u_Slots[11]); return;
-	case 12 : o_Color = Sample(u_Slots[12]); return;
-	case 13 : o_Color = Sample(u_Slots[13]); return;
-	case 14 : o_Color = Sample(u_Slots[14]); return;
-	case 15 : o_Color = Sample(u_Slots[15]); return;
-	case 16 : o_Color = Sample(u_Slots[16]); return;
-	case 17 : o_Color = Sample(u_Slots[17]); return;
-	case 18 : o_Color = Sample(u_Slots[18]); return;
-	case 19 : o_Color = Sample(u_Slots[19]); return;
-	case 20 : o_Color = Sample(u_Slots[20]); return;
-	case 21 : o_Color = Sample(u_Slots[21]); return;
-	case 22 : o_Color = Sample(u_Slots[22]); return;
-	case 23 : o_Color = Sample(u_Slots[23]); return;
-	case 24 : o_Color = Sample(u_Slots[24]); return;
-	case 25 : o_Color = Sample(u_Slots[25]); return;
-	case 26 : o_Color = Sample(u_Slots[26]); return;
-	case 27 : o_Color = Sample(u_Slots[27]); return;
-	case 28 : o_Color = Sample(u_Slots[28]); return;
-	case 29 : o_Color = Sample(u_Slots[29]); return;
-	case 30 : o_Color = Sample(u_Slots[30]); return;
-	case 31 : o_Color = Sample(u_Slots[31]); return;
+	case -1 : o_Color = v_Color; break; // Alpha clipping handled by Renderer2D class in C++
+	case  0 : o_Color = Sample(u_Slots[0 ]); break;
+	case  1 : o_Color = Sample(u_Slots[1 ]); break;
+	case  2 : o_Color = Sample(u_Slots[2 ]); break;
+	case  3 : o_Color = Sample(u_Slots[3 ]); break;
+	case  4 : o_Color = Sample(u_Slots[4 ]); break;
+	case  5 : o_Color = Sample(u_Slots[5 ]); break;
+	case  6 : o_Color = Sample(u_Slots[6 ]); break;
+	case  7 : o_Color = Sample(u_Slots[7 ]); break;
+	case  8 : o_Color = Sample(u_Slots[8 ]); break;
+	case  9 : o_Color = Sample(u_Slots[9 ]); break;
+	case 10 : o_Color = Sample(u_Slots[10]); break;
+	case 11 : o_Color = Sample(u_Slots[11]); break;
+	case 12 : o_Color = Sample(u_Slots[12]); break;
+	case 13 : o_Color = Sample(u_Slots[13]); break;
+	case 14 : o_Color = Sample(u_Slots[14]); break;
+	case 15 : o_Color = Sample(u_Slots[15]); break;
+	case 16 : o_Color = Sample(u_Slots[16]); break;
+	case 17 : o_Color = Sample(u_Slots[17]); break;
+	case 18 : o_Color = Sample(u_Slots[18]); break;
+	case 19 : o_Color = Sample(u_Slots[19]); break;
+	case 20 : o_Color = Sample(u_Slots[20]); break;
+	case 21 : o_Color = Sample(u_Slots[21]); break;
+	case 22 : o_Color = Sample(u_Slots[22]); break;
+	case 23 : o_Color = Sample(u_Slots[23]); break;
+	case 24 : o_Color = Sample(u_Slots[24]); break;
+	case 25 : o_Color = Sample(u_Slots[25]); break;
+	case 26 : o_Color = Sample(u_Slots[26]); break;
+	case 27 : o_Color = Sample(u_Slots[27]); break;
+	case 28 : o_Color = Sample(u_Slots[28]); break;
+	case 29 : o_Color = Sample(u_Slots[29]); break;
+	case 30 : o_Color = Sample(u_Slots[30]); break;
+	case 31 : o_Color = Sample(u_Slots[31]); break;
 	}
+#endif
+
+	// Blended additively, each layer brightens the pixel
+	if (u_Overdraw != 0)
+		o_Color = vec4(0.1, 0.05, 0.025, 1.0);
 }
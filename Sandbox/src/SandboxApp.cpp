@@ -4,15 +4,18 @@
 #include "SandboxLayer/SandboxLayer.h"
 #include "Sandbox2D/Sandbox2D.h"
 #include "SandboxECS/SandboxECS.h"
+#include "SandboxBenchmark/QuadBenchmark.h"
 
 class SandboxApp : public OverEngine::Application
 {
 public:
-	SandboxApp()
+	SandboxApp(const OverEngine::ApplicationProps& props)
+		: OverEngine::Application(props)
 	{
 		//PushLayer(new SandboxLayer());
 		//PushLayer(new Sandbox2D());
 		PushLayer(new SandboxECS());
+		//PushLayer(new QuadBenchmark());
 		m_ImGuiEnabled = true;
 	}
 
@@ -24,5 +27,14 @@ public:
 
 OverEngine::Application* OverEngine::CreateApplication(int argc, char** argv)
 {
-	return new SandboxApp();
+	OverEngine::ApplicationProps props;
+
+	// Run without a GPU or display, e.g. for profiling on CI machines
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--null-renderer") == 0)
+			props.RendererAPI = OverEngine::RendererAPI::API::Null;
+	}
+
+	return new SandboxApp(props);
 }
@@ -0,0 +1,119 @@
+#include "QuadBenchmark.h"
+
+#include "imgui/imgui.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace OverEngine;
+
+static const Vector4 s_QuadCorners[4] = {
+	{ -0.5f, -0.5f, 0.0f, 1.0f },
+	{  0.5f, -0.5f, 0.0f, 1.0f },
+	{  0.5f,  0.5f, 0.0f, 1.0f },
+	{ -0.5f,  0.5f, 0.0f, 1.0f },
+};
+
+static const Mat4x4 s_ViewProjection = glm::ortho(-100.0f, 100.0f, -100.0f, 100.0f, -1.0f, 1.0f);
+
+static double Smooth(double average, double sample)
+{
+	return average == 0.0 ? sample : average * 0.9 + sample * 0.1;
+}
+
+QuadBenchmark::QuadBenchmark()
+	: Layer("QuadBenchmark")
+{
+	GenerateQuads();
+}
+
+void QuadBenchmark::GenerateQuads()
+{
+	m_Quads.resize(m_QuadCount);
+	m_ReferenceVertices.resize(4 * (size_t)m_QuadCount);
+
+	for (int i = 0; i < m_QuadCount; i++)
+	{
+		QuadInstance& quad = m_Quads[i];
+		quad.Position = { (float)(i % 200) - 100.0f, (float)((i / 200) % 200) - 100.0f, 0.0f };
+		quad.Rotation = (float)i * 0.01f;
+		quad.Size = { 0.8f, 0.8f };
+		quad.Tint = { 1.0f, (float)(i % 256) / 255.0f, 0.5f, 1.0f };
+	}
+}
+
+double QuadBenchmark::RunReference()
+{
+	double start = Time::GetTimeDouble();
+
+	for (int i = 0; i < m_QuadCount; i++)
+	{
+		const QuadInstance& quad = m_Quads[i];
+
+		Mat4x4 transform = glm::translate(IDENTITY_MAT4X4, quad.Position) *
+			glm::rotate(IDENTITY_MAT4X4, quad.Rotation, { 0.0f, 0.0f, 1.0f }) *
+			glm::scale(IDENTITY_MAT4X4, { quad.Size.x, quad.Size.y, 1.0f });
+
+		for (int c = 0; c < 4; c++)
+			m_ReferenceVertices[4 * (size_t)i + c] = s_ViewProjection * transform * s_QuadCorners[c];
+	}
+
+	return Time::GetTimeDouble() - start;
+}
+
+double QuadBenchmark::RunDrawQuad()
+{
+	Renderer2D::BeginScene(s_ViewProjection);
+	double start = Time::GetTimeDouble();
+
+	for (const auto& quad : m_Quads)
+		Renderer2D::DrawQuad(quad.Position, quad.Rotation, quad.Size, quad.Tint);
+
+	double elapsed = Time::GetTimeDouble() - start;
+	Renderer2D::Reset();
+	return elapsed;
+}
+
+double QuadBenchmark::RunDrawQuads()
+{
+	Renderer2D::BeginScene(s_ViewProjection);
+	double start = Time::GetTimeDouble();
+
+	Renderer2D::DrawQuads(m_Quads);
+
+	double elapsed = Time::GetTimeDouble() - start;
+	Renderer2D::Reset();
+	return elapsed;
+}
+
+void QuadBenchmark::OnUpdate(TimeStep DeltaTime)
+{
+	RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+	RenderCommand::Clear();
+
+	if (!m_Running || m_QuadCount <= 0)
+		return;
+
+	m_ReferenceRate = Smooth(m_ReferenceRate, m_QuadCount / RunReference());
+	m_DrawQuadRate = Smooth(m_DrawQuadRate, m_QuadCount / RunDrawQuad());
+	m_DrawQuadsRate = Smooth(m_DrawQuadsRate, m_QuadCount / RunDrawQuads());
+}
+
+void QuadBenchmark::OnImGuiRender()
+{
+	ImGui::Begin("Quad Benchmark");
+
+	ImGui::Checkbox("Running", &m_Running);
+	if (ImGui::DragInt("Quad Count", &m_QuadCount, 1000.0f, 1000, 1000000))
+	{
+		GenerateQuads();
+		m_ReferenceRate = m_DrawQuadRate = m_DrawQuadsRate = 0.0;
+	}
+
+	ImGui::Separator();
+
+	ImGui::Text("Reference (per-corner MVP) : %.2f M quads/s", m_ReferenceRate / 1e6);
+	ImGui::Text("Renderer2D::DrawQuad       : %.2f M quads/s", m_DrawQuadRate / 1e6);
+	ImGui::Text("Renderer2D::DrawQuads      : %.2f M quads/s", m_DrawQuadsRate / 1e6);
+
+	ImGui::End();
+}
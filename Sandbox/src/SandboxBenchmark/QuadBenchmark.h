@@ -0,0 +1,38 @@
+#pragma once
+
+#include <OverEngine.h>
+
+using namespace OverEngine;
+
+/**
+ * Measures CPU cost of quad submission (vertex generation only, nothing is drawn).
+ * Compares the old per-corner matrix path against Renderer2D::DrawQuad and Renderer2D::DrawQuads.
+ */
+class QuadBenchmark : public Layer
+{
+public:
+	QuadBenchmark();
+
+	void OnAttach() override {};
+	void OnUpdate(TimeStep DeltaTime) override;
+	void OnImGuiRender() override;
+
+private:
+	void GenerateQuads();
+
+	double RunReference();
+	double RunDrawQuad();
+	double RunDrawQuads();
+
+private:
+	int m_QuadCount = 100000;
+	bool m_Running = true;
+
+	Vector<QuadInstance> m_Quads;
+	Vector<Vector4> m_ReferenceVertices;
+
+	// Quads per second, averaged over recent frames
+	double m_ReferenceRate = 0.0;
+	double m_DrawQuadRate = 0.0;
+	double m_DrawQuadsRate = 0.0;
+};
@@ -272,6 +272,22 @@ void SandboxECS::OnImGuiRender()
 	ImGui::Text("QuadCount : %i", Renderer2D::GetStatistics().QuadCount);
 	ImGui::Text("IndexCount : %i", Renderer2D::GetStatistics().GetIndexCount());
 	ImGui::Text("VertexCount : %i", Renderer2D::GetStatistics().GetVertexCount());
+	ImGui::Text("RetainedQuadCount : %i", Renderer2D::GetStatistics().RetainedQuadCount);
+	ImGui::Text("RetainedUploadCount : %i", Renderer2D::GetStatistics().RetainedUploadCount);
+	ImGui::Text("UploadedBytes : %llu", (unsigned long long)Renderer2D::GetStatistics().UploadedBytes);
+	ImGui::Text("VisibleSprites : %i", Renderer2D::GetStatistics().VisibleSpriteCount);
+	ImGui::Text("CulledSprites : %i", Renderer2D::GetStatistics().CulledSpriteCount);
+	ImGui::Text("ElidedGLCalls : %i", RenderCommand::GetElidedCallCount());
+	ImGui::Text("Batches : %i", Renderer2D::GetStatistics().BatchCount);
+	ImGui::Text("CPU Submit / Flush : %.3f / %.3f ms", Renderer2D::GetStatistics().SubmitMilliseconds, Renderer2D::GetStatistics().FlushMilliseconds);
+	ImGui::Text("GPU : %.3f ms", Renderer2D::GetStatistics().GPUMilliseconds);
+
+	if (Renderer2D::IsOverdrawDebug())
+	{
+		const auto& window = Application::Get().GetWindow();
+		float pixelCount = (float)window.GetWidth() * (float)window.GetHeight();
+		ImGui::Text("Overdraw : %.2f", pixelCount > 0.0f ? Renderer2D::GetStatistics().SamplesPassed / pixelCount : 0.0f);
+	}
 
 	if (ImGui::Button("Reload"))
 		Renderer2D::GetShader()->Reload();
@@ -285,6 +301,28 @@ void SandboxECS::OnImGuiRender()
 		Application::Get().GetWindow().SetVSync(VSync);
 	}
 
+	bool instanced = Renderer2D::IsInstancedRendering();
+	if (ImGui::Checkbox("Instanced Rendering", &instanced))
+		Renderer2D::SetInstancedRendering(instanced);
+
+	bool earlyDepth = Renderer2D::IsEarlyDepth();
+	if (ImGui::Checkbox("Early Depth", &earlyDepth))
+		Renderer2D::SetEarlyDepth(earlyDepth);
+
+	bool overdrawDebug = Renderer2D::IsOverdrawDebug();
+	if (ImGui::Checkbox("Overdraw Debug", &overdrawDebug))
+		Renderer2D::SetOverdrawDebug(overdrawDebug);
+
+	if (!Renderer2DCapture::IsRecording())
+	{
+		if (ImGui::Button("Record Capture"))
+			Renderer2DCapture::BeginRecording("Renderer2DCapture.oe2c");
+	}
+	else if (ImGui::Button("Stop Capture"))
+	{
+		Renderer2DCapture::EndRecording();
+	}
+
 	ImGui::End();
 }
 
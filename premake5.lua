@@ -68,3 +68,4 @@ group ""
 include "OverEngine"
 include "OverEditor"
 include "Sandbox"
+include "Benchmarks"